@@ -0,0 +1,783 @@
+/*
+ *  main.c
+ *  vanilla-bench
+ *
+ *  Copyright © 2024 UV Software. All rights reserved.
+ */
+#if !defined(_WIN32)
+#define _XOPEN_SOURCE 600
+#endif
+#include "vanilla.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#if !defined(_WIN32)
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <sys/time.h>
+#include <sys/resource.h>
+#include <unistd.h>
+#endif
+#if (OPTION_WRAP_MALLOC != 0)
+#include <pthread.h>
+#endif
+
+#define OPT_OUTPUT_LONG     "--output="
+#define OPT_OUTPUT_SHORT    "-o="
+#define OPT_REVISION_LONG   "--revision="
+#define OPT_REVISION_SHORT  "-r="
+#define OPT_ARG             '='
+
+#define TEXT_SIZE   ((size_t)2 * 1024 * 1024)  /* minimum size of a generated text */
+#define DEPTH       256         /* nesting depth of the deep documents */
+#define MEMBERS     1024        /* members of the wide objects */
+#define NUMBERS     100000
+#define ROUNDS      3
+#define MIN_TIME    0.1
+#if (OPTION_DISABLE_SIMD != 0)
+#define KERNEL      "swar"
+#else
+#define KERNEL      "simd"
+#endif
+
+#define PHASE_READ      0       /* json_parse_ex() or json_doc_parse() */
+#define PHASE_LOOKUP    1       /* json_find_value_of() and json_find_value_at() */
+#define PHASE_ITERATE   2       /* json_iter_next() */
+#define PHASE_DUMP      3       /* json_dump_to_buffer() */
+#define PHASE_FREE      4       /* json_free() */
+
+#define MODE_DEFAULT    0
+#define MODE_PARALLEL   1       /* JSON_OPT_PARALLEL */
+#define MODE_REUSE      2       /* reusable document */
+
+struct text {
+    char* buf;
+    size_t len;
+    size_t size;
+};
+struct corpus {
+    const char* name;
+    void (*generate)(struct text* text, int indent);
+};
+struct result {
+    const char* corpus;
+    const char* format;         /* minified, pretty, or tree */
+    int phase;
+    int mode;
+    size_t bytes;               /* bytes per operation */
+    double rate;                /* operations per second */
+    long allocs;                /* allocator calls per operation, or -1 */
+    long heap;                  /* peak heap per operation (in [Byte]), or -1 */
+    long rss;                   /* peak RSS of the process (in [KiB]), or -1 */
+};
+static void run_corpus(const struct corpus* corpus);
+static void run_phase(struct result* result, const struct text* text, int indent, int phase, int mode);
+static double run_once(const struct text* text, int indent, int phase, int mode, json_node_t tree, json_doc_t doc, size_t* bytes);
+static long lookup(json_node_t node);
+static long iterate(json_node_t node);
+static void report(const struct result* result);
+static long peak_rss(void);
+static void numbers(void);
+static double convert(json_node_t array, const double* values, int kernel);
+static void gen_records(struct text* text, int indent);
+static void gen_deep(struct text* text, int indent);
+static void gen_wide(struct text* text, int indent);
+static void gen_strings(struct text* text, int indent);
+static void gen_numbers(struct text* text, int indent);
+static void append(struct text* text, const char* string);
+static void newline(struct text* text, int indent, int level);
+static double now(void);
+static void usage_begin(void);
+static void usage_end(long* calls, long* peak);
+
+static const struct corpus corpora[] = {
+    { "records", gen_records },         /* records as written by json_dump() */
+    { "deep",    gen_deep },            /* deeply nested objects and arrays */
+    { "wide",    gen_wide },            /* objects with many members (hash index) */
+    { "strings", gen_strings },         /* long strings with some escapes */
+    { "numbers", gen_numbers }          /* arrays of integers and reals */
+};
+#define CORPORA  (int)(sizeof(corpora) / sizeof(corpora[0]))
+
+static const char* phases[] = { "read", "lookup", "iterate", "dump", "free" };
+static const char* modes[] = { "default", "parallel", "reuse" };
+
+static FILE* output = NULL;             /* machine-readable results (JSON Lines) */
+static const char* revision = "unknown";
+
+int main(int argc, char* argv[]) {
+    const char* selected[CORPORA + 1];
+    int count = 0;
+    int i, j;
+    char* ptr;
+
+    for (i = 1; i < argc; i++) {
+        if (!strncmp(argv[i], OPT_OUTPUT_LONG, strlen(OPT_OUTPUT_LONG)) ||
+            !strncmp(argv[i], OPT_OUTPUT_SHORT, strlen(OPT_OUTPUT_SHORT))) {
+            ptr = strchr(argv[i], OPT_ARG);
+            if (output || (*(++ptr) == '\0') || ((output = fopen(ptr, "a")) == NULL)) {
+                fprintf(stderr, "+++ error: invalid output file '%s'\n", ptr);
+                return 1;
+            }
+        } else if (!strncmp(argv[i], OPT_REVISION_LONG, strlen(OPT_REVISION_LONG)) ||
+                   !strncmp(argv[i], OPT_REVISION_SHORT, strlen(OPT_REVISION_SHORT))) {
+            ptr = strchr(argv[i], OPT_ARG);
+            if (*(++ptr) != '\0')
+                revision = ptr;
+        } else {
+            for (j = 0; (j < CORPORA) && strcmp(argv[i], corpora[j].name); j++)
+                ;
+            if (((j == CORPORA) && strcmp(argv[i], "conversions")) || (count == CORPORA + 1)) {
+                fprintf(stderr, "usage: %s [%s<file>] [%s<name>] [records|deep|wide|strings|numbers|conversions ...]\n",
+                        argv[0], OPT_OUTPUT_LONG, OPT_REVISION_LONG);
+                return 1;
+            }
+            selected[count++] = argv[i];
+        }
+    }
+    fprintf(stdout, "%-8s %-8s %-8s %-8s %-8s %10s %12s %10s %12s %10s\n", "kernel", "corpus", "format",
+            "phase", "mode", "MB/s", "docs/s", "allocs", "heap[B]", "rss[KiB]");
+    /* each corpus is run by a process of its own, i.e. the peak RSS
+     * is the one of the corpus (and not of the corpora before) */
+    for (i = 0; i <= CORPORA; i++) {
+        for (j = 0; (j < count) && strcmp(selected[j], (i < CORPORA) ? corpora[i].name : "conversions"); j++)
+            ;
+        if (count && (j == count))
+            continue;
+#if !defined(_WIN32)
+        {
+            pid_t pid;
+            int status;
+            (void)fflush(stdout);
+            if (output)
+                (void)fflush(output);
+            if ((pid = fork()) == 0) {
+                if (i < CORPORA)
+                    run_corpus(&corpora[i]);
+                else
+                    numbers();
+                exit(0);
+            }
+            if ((pid < 0) || (waitpid(pid, &status, 0) != pid) || !WIFEXITED(status) || WEXITSTATUS(status)) {
+                fprintf(stderr, "+++ error: benchmark '%s' failed\n", (i < CORPORA) ? corpora[i].name : "conversions");
+                return 1;
+            }
+        }
+#else
+        if (i < CORPORA)
+            run_corpus(&corpora[i]);
+        else
+            numbers();
+#endif
+    }
+    if (output)
+        (void)fclose(output);
+    return 0;
+}
+
+/*  read, lookup, iterate, dump and free the minified and the pretty text
+ */
+static void run_corpus(const struct corpus* corpus) {
+    struct text minified = { NULL, 0, 0 };
+    struct text pretty = { NULL, 0, 0 };
+    struct result result;
+    int mode;
+
+    corpus->generate(&minified, 0);
+    corpus->generate(&pretty, 2);
+    if (!minified.buf || !pretty.buf) {
+        fprintf(stderr, "+++ error: out of memory\n");
+        exit(1);
+    }
+    result.corpus = corpus->name;
+    for (mode = MODE_DEFAULT; mode <= MODE_REUSE; mode++) {
+        result.format = "minified";
+        run_phase(&result, &minified, 0, PHASE_READ, mode);
+        result.format = "pretty";
+        run_phase(&result, &pretty, 2, PHASE_READ, mode);
+    }
+    /* the tree is the same for both texts (but not its dump) */
+    result.format = "tree";
+    run_phase(&result, &minified, 0, PHASE_LOOKUP, MODE_DEFAULT);
+    run_phase(&result, &minified, 0, PHASE_ITERATE, MODE_DEFAULT);
+    result.format = "minified";
+    run_phase(&result, &minified, 0, PHASE_DUMP, MODE_DEFAULT);
+    result.format = "pretty";
+    run_phase(&result, &pretty, 2, PHASE_DUMP, MODE_DEFAULT);
+    result.format = "tree";
+    run_phase(&result, &minified, 0, PHASE_FREE, MODE_DEFAULT);
+
+    free(minified.buf);
+    free(pretty.buf);
+}
+
+/*  one pass counts the allocator calls, the best of some rounds is reported
+ */
+static void run_phase(struct result* result, const struct text* text, int indent, int phase, int mode) {
+    json_node_t tree = NULL;
+    json_doc_t doc = NULL;
+    double start, stop, busy;
+    double rate, best = 0.0;
+    size_t bytes = 0;
+    long count;
+    int i;
+
+    if ((phase != PHASE_READ) && (phase != PHASE_FREE) &&
+        ((tree = json_parse(text->buf, (jsize_t)text->len)) == NULL)) {
+        fprintf(stderr, "+++ error: parser failed\n");
+        exit(1);
+    }
+    if ((mode == MODE_REUSE) && ((doc = json_doc_new(JSON_OPT_DEFAULT)) == NULL)) {
+        fprintf(stderr, "+++ error: out of memory\n");
+        exit(1);
+    }
+    /* warm up (a reusable document gets its capacity and merges its chunks) */
+    (void)run_once(text, indent, phase, mode, tree, doc, &bytes);
+    (void)run_once(text, indent, phase, mode, tree, doc, &bytes);
+    usage_begin();
+    (void)run_once(text, indent, phase, mode, tree, doc, &bytes);
+    usage_end(&result->allocs, &result->heap);
+    for (i = 0; i < ROUNDS; i++) {
+        count = 0;
+        busy = 0.0;
+        start = now();
+        do {
+            busy += run_once(text, indent, phase, mode, tree, doc, &bytes);
+            count++;
+            stop = now();
+        } while ((stop - start) < MIN_TIME);
+        rate = (busy > 0.0) ? ((double)count / busy) : 0.0;
+        if (rate > best)
+            best = rate;
+    }
+    result->phase = phase;
+    result->mode = mode;
+    result->bytes = bytes;
+    result->rate = best;
+    result->rss = peak_rss();
+    report(result);
+    json_doc_free(doc);
+    json_free(tree);
+}
+
+/*  returns the time of one operation (w/o the set-up and the clean-up)
+ */
+static double run_once(const struct text* text, int indent, int phase, int mode, json_node_t tree, json_doc_t doc, size_t* bytes) {
+    static const unsigned int options[] = { JSON_OPT_DEFAULT, JSON_OPT_PARALLEL, JSON_OPT_DEFAULT };
+    json_node_t root = NULL;
+    char* buffer = NULL;
+    jsize_t length = 0;
+    double start, stop;
+    long sum = 0;
+
+    *bytes = text->len;
+    switch (phase) {
+    case PHASE_READ:
+        start = now();
+        if (mode == MODE_REUSE)
+            root = json_doc_parse(doc, text->buf, (jsize_t)text->len);
+        else
+            root = json_parse_ex(text->buf, (jsize_t)text->len, options[mode]);
+        stop = now();
+        if (!root) {
+            fprintf(stderr, "+++ error: parser failed\n");
+            exit(1);
+        }
+        if (mode != MODE_REUSE)
+            json_free(root);
+        break;
+    case PHASE_LOOKUP:
+        start = now();
+        sum = lookup(tree);
+        stop = now();
+        break;
+    case PHASE_ITERATE:
+        start = now();
+        sum = iterate(tree);
+        stop = now();
+        break;
+    case PHASE_DUMP:
+        start = now();
+        buffer = json_dump_to_buffer(tree, indent, &length);
+        stop = now();
+        if (!buffer) {
+            fprintf(stderr, "+++ error: out of memory\n");
+            exit(1);
+        }
+        *bytes = (size_t)length;
+        free(buffer);
+        break;
+    default:
+        if ((root = json_parse(text->buf, (jsize_t)text->len)) == NULL) {
+            fprintf(stderr, "+++ error: parser failed\n");
+            exit(1);
+        }
+        start = now();
+        json_free(root);
+        stop = now();
+        break;
+    }
+    if (sum < 0) {
+        fprintf(stderr, "+++ error: %s failed\n", phases[phase]);
+        exit(1);
+    }
+    return stop - start;
+}
+
+/*  looks up each member by its key and each element by its index
+ */
+static long lookup(json_node_t node) {
+    json_iter_t iter;
+    json_node_t value;
+    long count = 0, sum;
+    int index = 0;
+
+    if (json_iter_init(&iter, node) < 0)
+        return 0;
+    while ((value = json_iter_next(&iter)) != NULL) {
+        if (node->type == JSON_OBJECT) {
+            if (json_find_value_of(json_iter_key(&iter), node) == NULL)
+                return (-1);
+        } else if (json_find_value_at(index, node) != value) {
+            return (-1);
+        }
+        if ((sum = lookup(value)) < 0)
+            return (-1);
+        count += sum + 1;
+        index++;
+    }
+    return count;
+}
+
+/*  visits each value of the tree
+ */
+static long iterate(json_node_t node) {
+    json_iter_t iter;
+    json_node_t value;
+    long count = 0;
+
+    if (json_iter_init(&iter, node) < 0)
+        return 0;
+    while ((value = json_iter_next(&iter)) != NULL)
+        count += iterate(value) + 1;
+    return count;
+}
+
+static void report(const struct result* result) {
+    double seconds = (result->rate > 0.0) ? (1.0 / result->rate) : 0.0;
+    double mbps = (seconds > 0.0) ? ((double)result->bytes / (seconds * 1000000.0)) : 0.0;
+
+    fprintf(stdout, "%-8s %-8s %-8s %-8s %-8s %10.1f %12.1f %10ld %12ld %10ld\n", KERNEL, result->corpus,
+            result->format, phases[result->phase], modes[result->mode], mbps, result->rate,
+            result->allocs, result->heap, result->rss);
+    if (output) {
+        fprintf(output, "{\"revision\":\"%s\",\"kernel\":\"%s\",\"corpus\":\"%s\",\"format\":\"%s\","
+                "\"phase\":\"%s\",\"mode\":\"%s\",\"bytes\":%lu,\"mb_per_s\":%.3f,\"docs_per_s\":%.3f,",
+                revision, KERNEL, result->corpus, result->format, phases[result->phase], modes[result->mode],
+                (unsigned long)result->bytes, mbps, result->rate);
+        if (result->allocs >= 0)
+            fprintf(output, "\"allocs\":%ld,\"heap\":%ld,", result->allocs, result->heap);
+        else
+            fprintf(output, "\"allocs\":null,\"heap\":null,");
+        if (result->rss >= 0)
+            fprintf(output, "\"rss_kib\":%ld}\n", result->rss);
+        else
+            fprintf(output, "\"rss_kib\":null}\n");
+    }
+}
+
+static long peak_rss(void) {
+#if !defined(_WIN32)
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) < 0)
+        return (-1);
+#if defined(__APPLE__)
+    return (long)(usage.ru_maxrss / 1024);  /* in [Byte] */
+#else
+    return (long)usage.ru_maxrss;  /* in [KiB] */
+#endif
+#else
+    return (-1);
+#endif
+}
+
+#define KERNEL_STRTOD    0
+#define KERNEL_DOUBLE    1
+#define KERNEL_STRTOL    2
+#define KERNEL_INT64     3
+#define KERNEL_SPRINTF   4
+#define KERNEL_FORMAT    5
+
+static void numbers(void) {
+    static const char* names[] = {
+        "strtod", "json_get_double", "strtol", "json_get_int64", "sprintf(%.17g)", "json_format_double"
+    };
+    struct text reals = { NULL, 0, 0 };
+    struct text integers = { NULL, 0, 0 };
+    json_node_t array[2];
+    json_node_t node;
+    double* values;
+    double rate;
+    char number[64];
+    unsigned long seed = 12345UL;
+    int i, kernel;
+
+    /* reals as written by programs (e.g. 0.30000000000000004) and by people (e.g. 12.5) */
+    append(&reals, "[");
+    append(&integers, "[");
+    for (i = 0; i < NUMBERS; i++) {
+        seed = (seed * 1103515245UL + 12345UL) & 0x7FFFFFFFUL;
+        if (i % 2)
+            sprintf(number, "%s%.17g", i ? "," : "", (double)seed / 2147483648.0 * 1000.0);
+        else
+            sprintf(number, "%s%lu.%02lu", i ? "," : "", seed % 10000UL, seed % 100UL);
+        append(&reals, number);
+        sprintf(number, "%s%ld", i ? "," : "", (long)seed - 1073741824L);
+        append(&integers, number);
+    }
+    append(&reals, "]");
+    append(&integers, "]");
+    if (!reals.buf || !integers.buf ||
+        ((array[0] = json_parse(reals.buf, (jsize_t)reals.len)) == NULL) ||
+        ((array[1] = json_parse(integers.buf, (jsize_t)integers.len)) == NULL)) {
+        fprintf(stderr, "+++ error: out of memory\n");
+        exit(1);
+    }
+    if ((values = (double*)malloc(NUMBERS * sizeof(double))) == NULL) {
+        fprintf(stderr, "+++ error: out of memory\n");
+        exit(1);
+    }
+    for (i = 0, node = json_get_value_first(array[0]); node; node = json_get_value_next(array[0]))
+        values[i++] = json_get_double(node);
+    for (kernel = KERNEL_STRTOD; kernel <= KERNEL_FORMAT; kernel++) {
+        rate = convert(array[((kernel == KERNEL_STRTOL) || (kernel == KERNEL_INT64)) ? 1 : 0], values, kernel);
+        fprintf(stdout, "%-8s %-17s %-19s %12.1f Mnum/s\n", KERNEL, "conversions", names[kernel], rate);
+        if (output)
+            fprintf(output, "{\"revision\":\"%s\",\"kernel\":\"%s\",\"corpus\":\"conversions\",\"phase\":\"%s\","
+                    "\"mnum_per_s\":%.3f}\n", revision, KERNEL, names[kernel], rate);
+    }
+    free(values);
+    json_free(array[0]);
+    json_free(array[1]);
+    free(reals.buf);
+    free(integers.buf);
+}
+
+static double convert(json_node_t array, const double* values, int kernel) {
+    json_node_t node;
+    char buffer[JSON_DOUBLE_LENGTH];
+    double start, stop;
+    double rate, best = 0.0;
+    double sum = 0.0;
+    long count;
+    int i, j;
+
+    for (i = 0; i < ROUNDS; i++) {
+        count = 0;
+        start = now();
+        do {
+            for (j = 0, node = json_get_value_first(array); node; node = json_get_value_next(array), j++) {
+                switch (kernel) {
+                case KERNEL_STRTOD: sum += strtod(json_get_number(node, NULL, 0), NULL); break;
+                case KERNEL_DOUBLE: sum += json_get_double(node); break;
+                case KERNEL_STRTOL: sum += (double)strtol(json_get_number(node, NULL, 0), NULL, 10); break;
+                case KERNEL_INT64: sum += (double)json_get_int64(node); break;
+                case KERNEL_SPRINTF: sum += (double)sprintf(buffer, "%.17g", values[j]); break;
+                case KERNEL_FORMAT: sum += (double)json_format_double(values[j], buffer, sizeof(buffer)); break;
+                }
+                count++;
+            }
+            stop = now();
+        } while ((stop - start) < MIN_TIME);
+        rate = (double)count / ((stop - start) * 1000000.0);
+        if (rate > best)
+            best = rate;
+    }
+    if (sum == 0.5)  /* keep the results alive */
+        fprintf(stdout, " ");
+    return best;
+}
+
+/*  records as the output of json_dump() (indented) or without any whitespace
+ */
+static void gen_records(struct text* text, int indent) {
+    char number[64];
+    int i, j;
+
+    append(text, "[");
+    for (i = 0; (i == 0) || (text->buf && (text->len < TEXT_SIZE)); i++) {
+        if (i) append(text, ",");
+        newline(text, indent, 1);
+        append(text, "{");
+        newline(text, indent, 2);
+        sprintf(number, "\"id\":%s%i,", indent ? " " : "", i);
+        append(text, number);
+        newline(text, indent, 2);
+        append(text, indent ? "\"name\": \"record\"," : "\"name\":\"record\",");
+        newline(text, indent, 2);
+        sprintf(number, "\"score\":%s%i.%02i,", indent ? " " : "", i % 100, i % 97);
+        append(text, number);
+        newline(text, indent, 2);
+        append(text, indent ? "\"active\": true," : "\"active\":true,");
+        newline(text, indent, 2);
+        append(text, indent ? "\"tags\": [" : "\"tags\":[");
+        for (j = 0; j < 4; j++) {
+            if (j) append(text, ",");
+            newline(text, indent, 3);
+            append(text, "\"tag\"");
+        }
+        newline(text, indent, 2);
+        append(text, "]");
+        newline(text, indent, 1);
+        append(text, "}");
+    }
+    newline(text, indent, 0);
+    append(text, "]");
+}
+
+/*  documents with objects and arrays nested DEPTH levels deep
+ */
+static void gen_deep(struct text* text, int indent) {
+    int i, level;
+
+    append(text, "[");
+    for (i = 0; (i == 0) || (text->buf && (text->len < TEXT_SIZE)); i++) {
+        if (i) append(text, ",");
+        for (level = 0; level < DEPTH; level++) {
+            newline(text, indent, level + 1);
+            append(text, (level % 2) ? "[" : (indent ? "{\"next\": " : "{\"next\":"));
+        }
+        newline(text, indent, DEPTH + 1);
+        append(text, "null");
+        for (level = DEPTH - 1; level >= 0; level--) {
+            newline(text, indent, level + 1);
+            append(text, (level % 2) ? "]" : "}");
+        }
+    }
+    newline(text, indent, 0);
+    append(text, "]");
+}
+
+/*  objects with MEMBERS members each (i.e. with a hash index)
+ */
+static void gen_wide(struct text* text, int indent) {
+    char member[64];
+    int i, j;
+
+    append(text, "[");
+    for (i = 0; (i == 0) || (text->buf && (text->len < TEXT_SIZE)); i++) {
+        if (i) append(text, ",");
+        newline(text, indent, 1);
+        append(text, "{");
+        for (j = 0; j < MEMBERS; j++) {
+            if (j) append(text, ",");
+            newline(text, indent, 2);
+            if (j % 2)
+                sprintf(member, "\"key%04i\":%s\"value%i\"", j, indent ? " " : "", i);
+            else
+                sprintf(member, "\"key%04i\":%s%i", j, indent ? " " : "", i + j);
+            append(text, member);
+        }
+        newline(text, indent, 1);
+        append(text, "}");
+    }
+    newline(text, indent, 0);
+    append(text, "]");
+}
+
+/*  strings of 1 to 8 KiB, mostly plain text and some escape sequences
+ */
+static void gen_strings(struct text* text, int indent) {
+    static const char* words[] = {
+        "lorem ", "ipsum ", "dolor ", "sit ", "amet, ", "consectetur ", "adipiscing ", "elit. ",
+        "\\\"quoted\\\" ", "tab\\t", "line\\n", "caf\\u00e9 ", "back\\\\slash ", "sed ", "do ", "eiusmod "
+    };
+    unsigned long seed = 12345UL;
+    size_t length, end;
+    int i;
+
+    append(text, "[");
+    for (i = 0; (i == 0) || (text->buf && (text->len < TEXT_SIZE)); i++) {
+        if (i) append(text, ",");
+        newline(text, indent, 1);
+        append(text, "\"");
+        length = (size_t)1024 << (i % 4);
+        for (end = text->len + length; text->buf && (text->len < end); ) {
+            seed = (seed * 1103515245UL + 12345UL) & 0x7FFFFFFFUL;
+            /* one escape sequence in about 16 words */
+            append(text, words[((seed >> 16) % 64UL < 4UL) ? (8UL + (seed >> 8) % 5UL) : ((seed >> 8) % 8UL)]);
+        }
+        append(text, "\"");
+    }
+    newline(text, indent, 0);
+    append(text, "]");
+}
+
+/*  arrays of integers and reals (with fractions and exponents)
+ */
+static void gen_numbers(struct text* text, int indent) {
+    char number[64];
+    unsigned long seed = 12345UL;
+    int i, j;
+
+    append(text, "[");
+    for (i = 0; (i == 0) || (text->buf && (text->len < TEXT_SIZE)); i++) {
+        if (i) append(text, ",");
+        newline(text, indent, 1);
+        append(text, "[");
+        for (j = 0; j < 16; j++) {
+            seed = (seed * 1103515245UL + 12345UL) & 0x7FFFFFFFUL;
+            switch (j % 4) {
+            case 0: sprintf(number, "%ld", (long)seed - 1073741824L); break;
+            case 1: sprintf(number, "%lu.%02lu", seed % 10000UL, seed % 100UL); break;
+            case 2: sprintf(number, "%.17g", (double)seed / 2147483648.0); break;
+            default: sprintf(number, "%.6e", (double)seed * 1.0e10); break;
+            }
+            if (j) append(text, indent ? ", " : ",");
+            append(text, number);
+        }
+        append(text, "]");
+    }
+    newline(text, indent, 0);
+    append(text, "]");
+}
+
+static void newline(struct text* text, int indent, int level) {
+    static const char spaces[] = "                                                                ";
+    int i, n;
+    if (indent) {
+        append(text, "\n");
+        for (i = indent * level; i > 0; i -= n) {
+            n = (i < 64) ? i : 64;
+            append(text, &spaces[64 - n]);
+        }
+    }
+}
+
+static void append(struct text* text, const char* string) {
+    size_t length = strlen(string);
+    char* buf;
+    if (text->len + length + 1 > text->size) {
+        text->size = (text->size ? text->size * 2 : 65536) + length;
+        if ((buf = (char*)realloc(text->buf, text->size)) == NULL) {
+            free(text->buf);
+            text->buf = NULL;
+            text->len = text->size = 0;
+            return;
+        }
+        text->buf = buf;
+    }
+    if (text->buf) {
+        memcpy(&text->buf[text->len], string, length + 1);
+        text->len += length;
+    }
+}
+
+static double now(void) {
+#if !defined(_WIN32)
+    struct timespec ts;
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + ((double)ts.tv_nsec / 1000000000.0);
+#else
+    return (double)clock() / (double)CLOCKS_PER_SEC;
+#endif
+}
+
+/*  allocator calls and peak heap (GNU linker option --wrap, see Makefile)
+ */
+#if (OPTION_WRAP_MALLOC != 0)
+union header {                          /* block header (keeps the alignment): */
+    size_t size;                        /* - requested size */
+    long double pad;                    /* - strictest alignment */
+};
+static struct {
+    pthread_mutex_t mutex;
+    int counting;
+    long calls;
+    long heap;
+    long peak;
+} usage = { PTHREAD_MUTEX_INITIALIZER, 0, 0, 0, 0 };
+
+extern void* __real_malloc(size_t size);
+extern void* __real_realloc(void* ptr, size_t size);
+extern void __real_free(void* ptr);
+extern void* __wrap_malloc(size_t size);
+extern void* __wrap_calloc(size_t count, size_t size);
+extern void* __wrap_realloc(void* ptr, size_t size);
+extern void __wrap_free(void* ptr);
+
+static void count_usage(long size, int call) {
+    if (usage.counting) {
+        (void)pthread_mutex_lock(&usage.mutex);
+        usage.calls += call;
+        usage.heap += size;
+        if (usage.heap > usage.peak)
+            usage.peak = usage.heap;
+        (void)pthread_mutex_unlock(&usage.mutex);
+    }
+}
+
+void* __wrap_malloc(size_t size) {
+    union header* block;
+    if ((block = (union header*)__real_malloc(sizeof(union header) + size)) == NULL)
+        return NULL;
+    block->size = size;
+    count_usage((long)size, 1);
+    return (void*)(block + 1);
+}
+
+void* __wrap_calloc(size_t count, size_t size) {
+    void* ptr;
+    if (size && (count > ((size_t)-1 - sizeof(union header)) / size))
+        return NULL;
+    if ((ptr = __wrap_malloc(count * size)) != NULL)
+        memset(ptr, 0, count * size);
+    return ptr;
+}
+
+void* __wrap_realloc(void* ptr, size_t size) {
+    union header* block = ptr ? ((union header*)ptr - 1) : NULL;
+    size_t old = block ? block->size : 0;
+    if ((block = (union header*)__real_realloc(block, sizeof(union header) + size)) == NULL)
+        return NULL;
+    block->size = size;
+    count_usage((long)size - (long)old, 1);
+    return (void*)(block + 1);
+}
+
+void __wrap_free(void* ptr) {
+    union header* block;
+    if (ptr) {
+        block = (union header*)ptr - 1;
+        count_usage(-(long)block->size, 0);
+        __real_free(block);
+    }
+}
+
+static void usage_begin(void) {
+    (void)pthread_mutex_lock(&usage.mutex);
+    usage.calls = 0;
+    usage.heap = 0;
+    usage.peak = 0;
+    usage.counting = 1;
+    (void)pthread_mutex_unlock(&usage.mutex);
+}
+
+static void usage_end(long* calls, long* peak) {
+    (void)pthread_mutex_lock(&usage.mutex);
+    usage.counting = 0;
+    *calls = usage.calls;
+    *peak = usage.peak;
+    (void)pthread_mutex_unlock(&usage.mutex);
+}
+#else
+static void usage_begin(void) {
+}
+
+static void usage_end(long* calls, long* peak) {
+    /* not available */
+    *calls = (-1);
+    *peak = (-1);
+}
+#endif
@@ -62,6 +62,15 @@
  #define _CRT_SECURE_NO_WARNINGS 1
  #endif
 #endif
+#if !defined(_WIN32)
+ /*POSIX.1-2001 with 64-bit file offsets please!*/
+ #ifndef _POSIX_C_SOURCE
+ #define _POSIX_C_SOURCE 200112L
+ #endif
+ #ifndef _FILE_OFFSET_BITS
+ #define _FILE_OFFSET_BITS 64
+ #endif
+#endif
 
 /*  -----------  includes  -----------------------------------------------
  */
@@ -69,24 +78,172 @@
 #include <ctype.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <stddef.h>
 #include <string.h>
 #include <errno.h>
+#include <limits.h>
+#include <float.h>
+#include <math.h>
+#include <locale.h>
 #include <assert.h>
+#if !defined(_WIN32)
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
 
 /*  -----------  options  ------------------------------------------------
  */
-
+#ifndef JSON_HASH_THRESHOLD
+#define JSON_HASH_THRESHOLD  16         /* objects with at least n members get a hash index (0 = never) */
+#endif
+#ifndef JSON_MAX_DEPTH
+#define JSON_MAX_DEPTH  10000           /* maximum nesting depth of objects and arrays (0 = unlimited) */
+#endif
+#ifndef JSON_PARALLEL_THRESHOLD
+#define JSON_PARALLEL_THRESHOLD  1048576  /* arrays of at least n bytes are parsed in parallel (JSON_OPT_PARALLEL) */
+#endif
+#ifndef JSON_PARALLEL_THREADS
+#define JSON_PARALLEL_THREADS  0        /* number of threads of the parallel parser (0 = one per processor) */
+#endif
+#ifndef JSON_LINES_BATCH
+#define JSON_LINES_BATCH  262144        /* bytes of complete lines per batch (JSON Lines reader) */
+#endif
+#ifndef JSON_LINES_THREADS
+#define JSON_LINES_THREADS  4           /* at most n threads per processor (JSON Lines reader) */
+#endif
+#if (OPTION_DISABLE_SIMD == OPTION_DISABLED) && \
+    (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2)))
+#define SIMD_SSE2  1                    /* SSE2 is baseline on x86-64 */
+#if defined(__GNUC__) || defined(_MSC_VER)
+#define SIMD_AVX2  1                    /* AVX2 with runtime dispatch */
+#else
+#define SIMD_AVX2  0
+#endif
+#else
+#define SIMD_SSE2  0                    /* portable SWAR fallback */
+#define SIMD_AVX2  0
+#endif
+#if (SIMD_SSE2 != 0)
+#include <emmintrin.h>
+#endif
+#if (SIMD_AVX2 != 0) && defined(_WIN32)
+#include <windows.h>                    /* InitOnceExecuteOnce */
+#endif
+#if (SIMD_AVX2 != 0)
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#endif
+#if !defined(_WIN32)
+#define MMAP_SUPPORTED  1
+#else
+#define MMAP_SUPPORTED  0               /* the file is read (see json_read_ex in vanilla.h) */
+#endif
+#if defined(_MSC_VER)
+#define THREAD_LOCAL  __declspec(thread)
+#elif defined(__GNUC__)
+#define THREAD_LOCAL  __thread
+#else
+#define THREAD_LOCAL                    /* no thread-local storage: the last error is shared */
+#endif
+#if !defined(_WIN32) && defined(__GNUC__)
+#define THREADS_SUPPORTED  1            /* POSIX threads (the last error is thread-local) */
+#include <pthread.h>
+#else
+#define THREADS_SUPPORTED  0            /* sequential (see Parser Options in vanilla.h) */
+#endif
 
 /*  -----------  defines  ------------------------------------------------
  */
 #define TAB_SIZE  8
+#define IS_WHITESPACE(c)  (((c) == ' ') || ((c) == '\n') || ((c) == '\r') || ((c) == '\t'))
+#define IS_SPECIAL(c)     (((c) == '"') || ((c) == '\\') || ((unsigned char)(c) < 0x20U))
+#define SWAR_EQUAL(x,y,m) (~(((((x) ^ (y)) & (m)) + (m)) | ((x) ^ (y)) | (m)))
+#define SWAR_LESS(x,n,m)  (~((((x) & (m)) + ((m) / 0x7FU) * (0x80U - (n))) | (x) | (m)))
+#if (SIMD_AVX2 != 0) && defined(__GNUC__)
+#define TARGET_AVX2  __attribute__((target("avx2")))
+#else
+#define TARGET_AVX2
+#endif
+#define ALIGNMENT  sizeof(union json_align)
+#define ALIGN(n)   (((n) + (ALIGNMENT - 1U)) & ~(ALIGNMENT - 1U))
+#define CHUNK_HEADER     ALIGN(sizeof(struct json_chunk))
+#define CHUNK_SIZE_MIN   ((size_t)1024U)
+#define CHUNK_SIZE_MAX   ((size_t)64U * (size_t)1024U * (size_t)1024U)
+#define STACK_SIZE_MIN   ((size_t)256U)
+#define FRAME_SIZE_MIN   ((size_t)32U)
+#define WRITE_SIZE       ((size_t)64U * (size_t)1024U)  /* size of the output buffer (dump) */
+#define WRITE_SIZE_MIN   ((size_t)1024U)  /* initial size of a growable buffer (dump) */
+#define INT64_MAXIMUM    ((jint64_t)(((((jint64_t)1 << 62) - 1) * 2) + 1))
+#define INT64_MINIMUM    ((jint64_t)(-INT64_MAXIMUM - 1))
+#define TWO_POW_63       9223372036854775808.0
+#define SOURCE_BORROWED  0              /* source buffer owned by the caller */
+#define SOURCE_ALLOCATED 1              /* source buffer allocated by malloc */
+#define SOURCE_MAPPED    2              /* source buffer mapped into memory */
+#define SOURCE_RECYCLED  3              /* document owned by a reusable document */
+#define DOCUMENT_MAGIC   0x4A534F4EUL   /* tag of a JSON document ("JSON") */
+#define DOCUMENT(node)   ((struct json_document*)((char*)(node) - offsetof(struct json_document, root)))
+#define STATE_VALUE        0            /* event parser: a value is expected */
+#define STATE_FIRST_MEMBER 1            /* event parser: '}' or the first member is expected */
+#define STATE_MEMBER       2            /* event parser: a member is expected (after ',') */
+#define STATE_FIRST_ELEMENT 3           /* event parser: ']' or the first element is expected */
+#define STATE_NEXT         4            /* event parser: ',' or the end of an object/array is expected */
+#define STATE_DONE         5            /* event parser: the root value is complete */
+#define STATE_COLON        6            /* event parser: ':' is expected (after a key) */
+#define PARSE_SUSPENDED    2            /* event parser: suspended at the end of the buffer */
+#define NUMBER_CHARS     "0123456789+-.eE"
+#define LITERAL_CHARS    "abcdefghijklmnopqrstuvwxyz"
+#define CARRY_SIZE_MIN   ((size_t)256U)
+#define TAPE_SIZE_MIN    ((size_t)64U)
+#define RECORD_SIZE_MIN  ((size_t)64U)
+#define SLICE_SIZE_MIN   ((size_t)1024U)  /* smallest chunk of text per thread (parallel parser) */
+#define BATCH_EMPTY      0              /* JSON Lines: the batch can be filled */
+#define BATCH_READY      1              /* JSON Lines: the batch is filled, but not parsed */
+#define BATCH_BUSY       2              /* JSON Lines: the batch is being parsed */
+#define BATCH_DONE       3              /* JSON Lines: the batch is parsed */
+#define U64(hi,lo)       (((json_uint64_t)(hi) << 32) | (json_uint64_t)(lo))
+#define DOUBLE_BITS      52             /* explicit bits of the significand (double) */
+#define DOUBLE_HIDDEN    ((json_uint64_t)1 << DOUBLE_BITS)
+#define DOUBLE_INFINITY  ((json_uint64_t)0x7FFU << DOUBLE_BITS)
+#define DOUBLE_SIGN      ((json_uint64_t)1 << 63)
+#define DOUBLE_DIGITS    19             /* significant digits in 64 bits (decimal) */
+#define DOUBLE_LENGTH    32             /* buffer size for a formatted double */
+#define POW5_MIN         (-342)         /* smallest power of 5 (table) */
+#define POW5_MAX         308            /* greatest power of 5 (table) */
+#define POW10_EXACT      22             /* greatest power of 10 exact as double */
+#define EXPONENT_MAX     100000L        /* saturation of decimal exponents */
+#if defined(_M_X64) || defined(_M_ARM64) || (defined(__FLT_EVAL_METHOD__) && (__FLT_EVAL_METHOD__ == 0))
+#define EXACT_DOUBLE     1              /* double arithmetic is not extended (Clinger's fast path) */
+#else
+#define EXACT_DOUBLE     0
+#endif
+#define TAPE_SHIFT       56             /* tag of a tape word (upper 8 bits) */
+#define TAPE_FLAG_SHIFT  53             /* number flags of a tape word (next 3 bits) */
+#define TAPE_MASK        (((json_word_t)1 << TAPE_FLAG_SHIFT) - 1U)
+#define TAPE_WORD(tag,n) (((json_word_t)(tag) << TAPE_SHIFT) | (json_word_t)(n))
+#define TAPE_TAG(word)   ((int)((word) >> TAPE_SHIFT))
+#define TAPE_FLAGS(word) ((int)(((word) >> TAPE_FLAG_SHIFT) & 0x7U))
+#define TAPE_OFFSET(word) ((size_t)((word) & TAPE_MASK))
+#define TAPE_OBJECT      '{'            /* object (index of its end word) */
+#define TAPE_ARRAY       '['            /* array (index of its end word) */
+#define TAPE_END         '.'            /* end of an object or array (number of members or elements) */
+#define TAPE_KEY         ':'            /* key of a member (offset of the string) */
+#define TAPE_STRING      '"'            /* string (offset of the string) */
+#define TAPE_NUMBER      '0'            /* number (offset of the string, and flags) */
+#define TAPE_TRUE        't'            /* literal true */
+#define TAPE_FALSE       'f'            /* literal false */
+#define TAPE_NULL        'n'            /* literal null */
 #if (DEBUG_VALUE != 0)
 #define DEBUG_STRING(str)  do { printf(">>> string(%d): \"%s\"\n", (int)strlen(str), str); } while(0)
 #define DEBUG_NUMBER(str)  do { printf(">>> number: %s\n", str); } while(0)
 #define DEBUG_LITERAL(str) do { printf(">>> literal: %s\n", str); } while(0)
 #if (NOT_RECURSIVE != 0)
-#define DEBUG_ARRAY(node)  do { dump_array(node, 0, stdout); } while(0)
-#define DEBUG_OBJECT(node) do { dump_object(node, 0, stdout); } while(0)
+#define DEBUG_ARRAY(node)  do { (void)dump_file(node, NULL, JSON_INDENT_DEFAULT); } while(0)
+#define DEBUG_OBJECT(node) do { (void)dump_file(node, NULL, JSON_INDENT_DEFAULT); } while(0)
 #else
 #define DEBUG_ARRAY(node)  do { } while(0)
 #define DEBUG_OBJECT(node) do { } while(0)
@@ -101,108 +258,1695 @@
 
 /*  -----------  types  --------------------------------------------------
  */
+#if (OPTION_INCLUDE_STDINT_H != OPTION_DISABLED)
+typedef uint64_t  json_uint64_t;        /* unsigned 64-bit integer */
+#elif defined(_MSC_VER)
+typedef unsigned __int64  json_uint64_t;  /* unsigned 64-bit integer */
+#elif defined(__GNUC__)
+__extension__ typedef unsigned long long  json_uint64_t;  /* C90: long long as GNU extension */
+#else
+typedef unsigned long long  json_uint64_t;  /* unsigned 64-bit integer */
+#endif
+typedef json_uint64_t  json_word_t;     /* tape word (64-bit) */
+union json_align {                      /* strictest alignment: */
+    void* ptr;                          /* - pointer */
+    double num;                         /* - floating point */
+    long val;                           /* - integer */
+    size_t len;                         /* - size */
+};
+struct json_chunk {                     /* arena chunk: */
+    struct json_chunk* next;            /* - pointer to next chunk */
+    size_t size;                        /* - size of the chunk (payload) */
+    size_t used;                        /* - bytes used from the chunk */
+};
+struct json_arena {                     /* bump allocator (arena): */
+    struct json_chunk* head;            /* - current chunk (to allocate from) */
+    size_t grow;                        /* - size of the next chunk */
+};
+struct json_document {                  /* JSON document: */
+    unsigned long magic;                /* - DOCUMENT_MAGIC (to recognize a root node) */
+    struct json_document* self;         /* - the document itself (cannot come from a text) */
+    struct json_node root;              /* - root node (see macro DOCUMENT) */
+    struct json_arena arena;            /* - all nodes, members, elements and strings */
+    char* source;                       /* - source buffer (in-situ mode) */
+    size_t length;                      /* - length of the source buffer */
+    int owner;                          /* - owner of the source buffer */
+};
+
+struct json_frame {                     /* parser frame (open object or array): */
+    json_type_t type;                   /* - JSON_OBJECT or JSON_ARRAY */
+    struct json_node* node;             /* - the object or the array (or NULL) */
+    struct json_member* last;           /* - last member so far (object) */
+    size_t base;                        /* - first element on the scratch stack (array) */
+    size_t count;                       /* - number of members so far (object) */
+};
+struct json_diyfp {                     /* floating point value (Grisu): */
+    json_uint64_t f;                    /* - significand */
+    int e;                              /* - binary exponent */
+};
+struct json_writer {                    /* output buffer (dump): */
+    char* buffer;                       /* - buffered text */
+    size_t length;                      /* - length of the buffered text */
+    size_t size;                        /* - size of the buffer (w/o terminator in memory) */
+    size_t total;                       /* - length of the whole text (required size) */
+    json_write_t write;                 /* - output callback, or NULL (in memory) */
+    void* context;                      /* - context of the output callback */
+    int grow;                           /* - the buffer can grow (in memory) */
+    int indent;                         /* - spaces per nesting level (0 = minified) */
+    int error;                          /* - errno of the (first) error, or 0 */
+};
+struct json_cursor {                    /* dump cursor (open object or array): */
+    struct json_node* node;             /* - the object or the array */
+    struct json_member* member;         /* - next member (object) */
+    int index;                          /* - index of next element (array) */
+    int depth;                          /* - indentation depth */
+};
+
 typedef struct json_file {              /* JSON file content: */
-    char* buf;                          /* - string buffer (entire file) */
-    long len;                           /* - length of the buffer/file */
-    long pos;                           /* - current read position */
-    long row;                           /* - current line number */
-    long col;                           /* - current column number */
+    const char* buf;                    /* - string buffer (entire file) */
+    size_t len;                         /* - length of the buffer/file */
+    size_t pos;                         /* - current read position */
+    struct json_arena* arena;           /* - arena for the document tree */
+    char* insitu;                       /* - writable buffer (in-situ mode) */
+    unsigned int options;               /* - parser options */
+    struct json_node** stack;           /* - scratch stack (array elements) */
+    size_t top;                         /* - top of the scratch stack */
+    size_t size;                        /* - size of the scratch stack */
+    struct json_frame* frame;           /* - parser stack (open objects and arrays) */
+    size_t depth;                       /* - nesting depth (top of the parser stack) */
+    size_t levels;                      /* - size of the parser stack */
+    int error;                          /* - reason of the (first) error */
+    size_t fail;                        /* - position of the (first) error */
+    int state;                          /* - state of the event parser (STATE_xyz) */
+    int final;                          /* - the buffer is the end of the text */
+    size_t root;                        /* - depth of the root value (1 in a slice) */
 } json_file_t, *JSON;
 
+struct json_slice {                     /* slice of a top-level array (parallel parser): */
+    const char* buf;                    /* - the whole text */
+    size_t len;                         /* - length of the whole text */
+    size_t begin;                       /* - first character of the chunk */
+    size_t end;                         /* - end of the chunk */
+    int quotes;                         /* - the chunk has an odd number of quotes */
+    long delta[2];                      /* - change of depth, starting outside [0] or inside [1] a string */
+    int string;                         /* - the chunk starts inside a string */
+    long depth;                         /* - depth at the begin of the chunk */
+    size_t stop;                        /* - end of the slice (comma or end of text) */
+    const struct json_slice* next;      /* - the next slice, or NULL (the last one) */
+    json_file_t file;                   /* - parser of the slice (elements on its stack) */
+    struct json_arena arena;            /* - arena of the slice */
+    int error;                          /* - errno value if the slice could not be parsed */
+};
+
+struct json_tape {                      /* tape (read-only document): */
+    json_word_t* word;                  /* - tagged words (in the order of the text) */
+    size_t count;                       /* - number of words */
+    size_t size;                        /* - size of the word array */
+    char* string;                       /* - all strings (zero-terminated) */
+    size_t length;                      /* - length of all strings */
+    size_t capacity;                    /* - size of the string buffer */
+    unsigned int options;               /* - parser options */
+};
+struct json_recorder {                  /* tape recorder (event handler): */
+    JSON json;                          /* - event parser (its stack) */
+    struct json_tape* tape;             /* - the tape */
+};
+struct json_token {                     /* reference token (JSON path): */
+    const char* string;                 /* - key (unescaped, zero-terminated) */
+    unsigned long hash;                 /* - hash of the key */
+    int index;                          /* - array index, or -1 if none */
+};
+struct json_path {                      /* JSON path (compiled JSON Pointer): */
+    struct json_token* token;           /* - reference tokens (followed by the keys) */
+    size_t count;                       /* - number of reference tokens */
+};
+struct json_lookup {                    /* JSON path of a batch evaluation: */
+    const struct json_path* path;       /* - the JSON path */
+    int slot;                           /* - position of its result */
+};
+
+struct json_record {                    /* line of a batch (JSON Lines): */
+    json_node_t root;                   /* - document, or NULL on error */
+    json_error_t error;                 /* - reason and location on error (in the line) */
+    int code;                           /* - errno value on error */
+    size_t offset;                      /* - offset of the line in the batch */
+    long line;                          /* - line number in the batch (from 0) */
+};
+struct json_batch {                     /* batch of complete lines (JSON Lines): */
+    char* text;                         /* - text of the lines */
+    size_t length;                      /* - length of the text */
+    size_t size;                        /* - size of the text buffer */
+    size_t offset;                      /* - offset of the text in the file */
+    long lines;                         /* - number of line feeds in the text */
+    struct json_record* record;         /* - parsed lines (except empty lines) */
+    size_t count;                       /* - number of parsed lines */
+    size_t capacity;                    /* - size of the record array */
+    size_t next;                        /* - next record to be returned */
+    int code;                           /* - errno value if not all lines were parsed */
+    int state;                          /* - BATCH_EMPTY, _READY, _BUSY or _DONE */
+};
+struct json_lines {                     /* JSON Lines reader: */
+    FILE* fp;                           /* - the file (or stdin) */
+    unsigned int options;               /* - parser options */
+    struct json_batch* batch;           /* - ring of batches */
+    int slots;                          /* - number of batches */
+    int head;                           /* - oldest batch (to be returned next) */
+    int fill;                           /* - next batch to be filled */
+    int work;                           /* - next batch to be parsed */
+    char* carry;                        /* - incomplete line (end of the last batch) */
+    size_t carried;                     /* - length of the incomplete line */
+    size_t capacity;                    /* - size of the carry buffer */
+    size_t offset;                      /* - offset of the next batch in the file */
+    long line;                          /* - line number of the oldest batch */
+    int eof;                            /* - the file is read completely */
+    int code;                           /* - errno value if the file could not be read */
+    int quit;                           /* - the threads shall terminate */
+    int threads;                        /* - number of worker threads */
+#if (THREADS_SUPPORTED != 0)
+    pthread_t* thread;                  /* - worker threads */
+    pthread_mutex_t mutex;              /* - guards the state of the batches */
+    pthread_cond_t ready;               /* - a batch is ready to be parsed (or quit) */
+    pthread_cond_t done;                /* - a batch is parsed */
+#endif
+};
+
+struct json_doc {                       /* reusable document: */
+    struct json_document doc;           /* - the document (must be the first member!) */
+    unsigned int options;               /* - parser options */
+    char* text;                         /* - copy of the text (in-situ mode) */
+    size_t capacity;                    /* - size of the copy */
+    struct json_node** stack;           /* - scratch stack (kept between documents) */
+    size_t size;                        /* - size of the scratch stack */
+    struct json_frame* frame;           /* - parser stack (kept between documents) */
+    size_t levels;                      /* - size of the parser stack */
+};
+
+struct json_parser {                    /* push parser: */
+    json_file_t file;                   /* - event parser (state and stacks) */
+    const json_handler_t* handler;      /* - event handler (or the tree builder) */
+    void* context;                      /* - user context (or the parser itself) */
+    struct json_document* doc;          /* - document (tree mode only) */
+    struct json_node* root;             /* - root value (tree mode only) */
+    char* carry;                        /* - incomplete token (from the last chunk) */
+    size_t carried;                     /* - length of the incomplete token */
+    size_t capacity;                    /* - size of the carry buffer */
+    int escape;                         /* - the carried string ends with a backslash */
+    size_t offset;                      /* - offset of the next chunk (or carry) */
+    long line;                          /* - line number at the offset */
+    long column;                        /* - column number at the offset */
+    int status;                         /* - 1 if stopped, -1 on error, otherwise 0 */
+};
+
 /*  -----------  prototypes  ---------------------------------------------
  */
+static char* load_file(const char* filename, size_t* length);
+#if (MMAP_SUPPORTED != 0)
+static char* map_file(const char* filename, size_t* length, int writable);
+static void unmap_file(char* buffer, size_t length);
+#endif
+static void free_source(char* buffer, size_t length, int owner);
+static json_node_t parse_buffer(const char* buffer, size_t length, unsigned int options);
+static json_node_t parse_tree(JSON json, struct json_document* doc, const char* buffer, size_t length, unsigned int options);
+static json_node_t keep_source(json_node_t root, char* buffer, size_t length, int owner);
+static void parse_error(JSON json, int reason);
+static void set_last_error(int reason, const char* buffer, size_t offset);
+static void count_lines(const char* buffer, size_t length, long* line, long* column);
 static json_node_t parse_value(JSON json);
 static json_node_t parse_string(JSON json);
 static json_node_t parse_number(JSON json);
-static json_node_t parse_object(JSON json);
-static json_node_t parse_array(JSON json);
+static json_node_t open_object(JSON json);
+static json_node_t open_array(JSON json);
+static json_node_t close_object(JSON json, struct json_frame* frame);
+static json_node_t close_array(JSON json, struct json_frame* frame);
+static int next_member(JSON json);
+static int push_frame(JSON json, json_type_t type, json_node_t node);
+static int parse_stream(JSON json, const char* buffer, size_t length, const json_handler_t* handler, void* context);
+static int parse_events(JSON json, const json_handler_t* handler, void* context);
+static int next_key(JSON json, const json_handler_t* handler, void* context);
+static int suspend(JSON json, size_t start);
+static size_t skip_token(const char* buf, size_t pos, size_t len, const char* chars);
+static int feed_chunk(struct json_parser* parser, const char* chunk, size_t length);
+static size_t complete_token(struct json_parser* parser, const char* chunk, size_t length, int* done);
+static int run_buffer(struct json_parser* parser, const char* buffer, size_t length);
+static int append_carry(struct json_parser* parser, const char* data, size_t length);
+static size_t scan_escaped(const char* buf, size_t idx, size_t len, int* escape);
+static int build_start_object(void* context);
+static int build_end_object(void* context);
+static int build_start_array(void* context);
+static int build_end_array(void* context);
+static int build_key(void* context, const char* string, jsize_t length);
+static int build_string(void* context, const char* string, jsize_t length);
+static int build_number(void* context, const char* string, jsize_t length);
+static int build_literal(void* context, json_type_t type);
+static int build_value(struct json_parser* parser, json_node_t node);
+static int build_error(JSON json);
+static struct json_tape* tape_buffer(const char* buffer, size_t length, unsigned int options);
+static size_t tape_skip(const struct json_tape* tape, size_t index);
+static void tape_decode(const struct json_tape* tape, size_t index, struct json_number* number);
+static int tape_word(JSON json, struct json_tape* tape, json_word_t word);
+static int tape_text(JSON json, struct json_tape* tape, const char* string, size_t length, size_t extra, size_t* offset);
+static void tape_count(JSON json, size_t level);
+static int tape_start(void* context, int tag);
+static int tape_end(void* context);
+static int tape_start_object(void* context);
+static int tape_start_array(void* context);
+static int tape_key(void* context, const char* string, jsize_t length);
+static int tape_string(void* context, const char* string, jsize_t length);
+static int tape_number(void* context, const char* string, jsize_t length);
+static int tape_literal(void* context, json_type_t type);
+#if (THREADS_SUPPORTED != 0)
+static json_node_t parse_parallel(JSON json, int threads);
+static void* scan_chunk(void* context);
+static void* parse_slice(void* context);
+static size_t find_split(const char* buf, size_t pos, size_t len, int string, long depth);
+static int is_escaped(const char* buf, size_t pos);
+#if (SIMD_SSE2 != 0)
+static unsigned int count_bits(unsigned int mask);
+#endif
+static void run_threads(void* (*task)(void*), struct json_slice* slice, int count);
+#endif
+static int count_processors(void);
+static int fill_batch(struct json_lines* lines, struct json_batch* batch);
+static void parse_lines(struct json_batch* batch, unsigned int options);
+static void take_batch(struct json_lines* lines, int slot);
+static void free_batch(struct json_batch* batch);
+#if (THREADS_SUPPORTED != 0)
+static void* lines_worker(void* context);
+#endif
+static void lines_lock(struct json_lines* lines);
+static void lines_unlock(struct json_lines* lines);
+static int path_index(const char* string);
+static json_node_t path_step(json_node_t node, const struct json_token* token);
+static size_t path_prefix(const struct json_path* path, const struct json_path* other);
+static int path_compare(const void* lhs, const void* rhs);
 static json_node_t parse_literal(JSON json, json_type_t type);
-static void dump_value(json_node_t node, int depth, FILE* fp);
-static void dump_string(json_node_t node, int depth, FILE* fp);
-static void dump_number(json_node_t node, int depth, FILE* fp);
-static void dump_object(json_node_t node, int depth, FILE* fp);
-static void dump_array(json_node_t node, int depth, FILE* fp);
-static void dump_literal(json_node_t node, int depth, FILE* fp);
-static void dump_value(json_node_t node, int depth, FILE* fp);
-static void free_value(json_node_t node);
-static void free_string(json_node_t node);
-static void free_number(json_node_t node);
-static void free_object(json_node_t node);
-static void free_array(json_node_t node);
-static void free_literal(json_node_t node);
+static char* get_token(JSON json, size_t length);
+static void decode_number(struct json_number* number, const char* string);
+static jint64_t number_int64(const struct json_number* number);
+static double number_double(const struct json_number* number);
+static double parse_double(const char* string, int* range);
+static int lemire_double(json_uint64_t w, long q, json_uint64_t* bits);
+static double locale_strtod(const char* string);
+static double make_double(json_uint64_t bits);
+static json_uint64_t double_bits(double value);
+static void multiply_64(json_uint64_t a, json_uint64_t b, json_uint64_t* hi, json_uint64_t* lo);
+static int leading_zeros(json_uint64_t x);
+static int format_double(double value, char* buffer);
+static int grisu_digits(double value, char* buffer, int* K);
+static int shorten_digits(double value, char* buffer, int length, int* K);
+static struct json_diyfp diyfp_multiply(struct json_diyfp x, struct json_diyfp y);
+static void grisu_round(char* buffer, int length, json_uint64_t delta, json_uint64_t rest, json_uint64_t ten_kappa, json_uint64_t wp_w);
+static int dump_file(json_node_t node, const char* filename, int indent);
+static int dump_stream(json_node_t node, int indent, json_write_t write, void* context);
+static int write_file(void* context, const char* data, jsize_t length);
+static void dump_value(json_node_t node, int depth, struct json_writer* writer);
+static void dump_string(json_node_t node, int depth, struct json_writer* writer);
+static void dump_number(json_node_t node, int depth, struct json_writer* writer);
+static void dump_literal(json_node_t node, int depth, struct json_writer* writer);
+static void write_text(struct json_writer* writer, const char* text, size_t length);
+static void write_char(struct json_writer* writer, char c);
+static void write_indent(struct json_writer* writer, int depth);
+static void write_flush(struct json_writer* writer);
+static int write_grow(struct json_writer* writer, size_t length);
+static struct json_cursor* grow_cursor(struct json_cursor** stack, size_t* size);
+static void free_document(struct json_document* doc);
+static json_node_t new_node(JSON json, json_type_t type);
+static int push_value(JSON json, json_node_t value);
+static int make_index(JSON json, json_node_t node, size_t count);
+static struct json_member* find_member(const struct json_node* node, const char* string);
+static struct json_member* find_hashed(const struct json_node* node, const char* string, unsigned long hash);
+static unsigned long hash_string(const char* string);
+static void arena_init(struct json_arena* arena, size_t length);
+static void* arena_alloc(struct json_arena* arena, size_t size);
+static char* arena_strndup(struct json_arena* arena, const char* string, size_t length);
+static void arena_reset(struct json_arena* arena);
+static void arena_free(struct json_arena* arena);
 static char* get_string(JSON json);
-static long scan_string(JSON json);
-static long scan_number(JSON json);
-static long scan_fraction(JSON json, long* idx);
-static long scan_exponent(JSON json, long* idx);
-static long scan_digits(JSON json, long* idx);
-static long scan_literal(JSON json, const char* literal);
+static const char* match_string(JSON json, size_t* length);
+static size_t scan_string(JSON json);
+static size_t scan_number(JSON json);
+static size_t scan_fraction(JSON json, size_t* idx);
+static size_t scan_exponent(JSON json, size_t* idx);
+static size_t scan_digits(JSON json, size_t* idx);
+static size_t scan_literal(JSON json, const char* literal);
 static char get_char(JSON json);
 static char lookahead(JSON json);
+static size_t skip_scalar(const char* buf, size_t pos, size_t len);
+static size_t find_scalar(const char* buf, size_t pos, size_t len);
+#if (SIMD_SSE2 == 0)
+static size_t skip_swar(const char* buf, size_t pos, size_t len);
+static size_t find_swar(const char* buf, size_t pos, size_t len);
+#endif
+#if (SIMD_SSE2 != 0)
+static size_t skip_sse2(const char* buf, size_t pos, size_t len);
+static size_t find_sse2(const char* buf, size_t pos, size_t len);
+static unsigned int first_bit(unsigned int mask);
+#endif
+#if (SIMD_AVX2 != 0)
+TARGET_AVX2 static size_t skip_avx2(const char* buf, size_t pos, size_t len);
+TARGET_AVX2 static size_t find_avx2(const char* buf, size_t pos, size_t len);
+static int cpu_has_avx2(void);
+#endif
+static void init_kernels(void);
+#if (SIMD_AVX2 != 0)
+static void select_kernels(void);
+#if (THREADS_SUPPORTED == 0)
+static BOOL CALLBACK select_once(PINIT_ONCE once, PVOID parameter, PVOID* context);
+#endif
+#endif
 
 /*  -----------  variables  ----------------------------------------------
  */
-
+static struct json_node json_true = { JSON_TRUE, { "true" } };
+static struct json_node json_false = { JSON_FALSE, { "false" } };
+static struct json_node json_null = { JSON_NULL, { "null" } };
+#if (SIMD_SSE2 != 0)
+static size_t (*skip_whitespace)(const char* buf, size_t pos, size_t len) = skip_sse2;
+static size_t (*find_special)(const char* buf, size_t pos, size_t len) = find_sse2;
+#else
+static size_t (*skip_whitespace)(const char* buf, size_t pos, size_t len) = skip_swar;
+static size_t (*find_special)(const char* buf, size_t pos, size_t len) = find_swar;
+#endif
+static THREAD_LOCAL json_error_t last_error = { JSON_ERR_NONE, 0, 0, 0, NULL };
+static const json_handler_t tree_builder = {
+    build_start_object, build_end_object, build_start_array, build_end_array,
+    build_key, build_string, build_number, build_literal
+};
+static const json_handler_t tape_recorder = {
+    tape_start_object, tape_end, tape_start_array, tape_end,
+    tape_key, tape_string, tape_number, tape_literal
+};
+static const char* error_messages[] = {
+    "no error",
+    "unexpected character",
+    "unexpected end of text",
+    "invalid string",
+    "invalid number",
+    "invalid literal",
+    "out of memory",
+    "implementation limit exceeded",
+    "file could not be read",
+    "invalid argument",
+    "nesting too deep"
+};
+static const double pow10_exact[POW10_EXACT + 1] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+static const unsigned long pow10_32[10] = {
+    1UL, 10UL, 100UL, 1000UL, 10000UL, 100000UL, 1000000UL, 10000000UL, 100000000UL, 1000000000UL
+};
+/*  powers of 5 from 5^-342 to 5^308 as 128-bit values (high and low 64 bits),
+ *  normalized (the most significant bit set), for the Eisel-Lemire algorithm
+ */
+static const json_uint64_t pow5_128[2 * (POW5_MAX - POW5_MIN + 1)] = {
+    U64(0xEEF453D6UL, 0x923BD65AUL), U64(0x113FAA29UL, 0x06A13B3FUL),  /* 5^-342 */
+    U64(0x9558B466UL, 0x1B6565F8UL), U64(0x4AC7CA59UL, 0xA424C507UL),  /* 5^-341 */
+    U64(0xBAAEE17FUL, 0xA23EBF76UL), U64(0x5D79BCF0UL, 0x0D2DF649UL),  /* 5^-340 */
+    U64(0xE95A99DFUL, 0x8ACE6F53UL), U64(0xF4D82C2CUL, 0x107973DCUL),  /* 5^-339 */
+    U64(0x91D8A02BUL, 0xB6C10594UL), U64(0x79071B9BUL, 0x8A4BE869UL),  /* 5^-338 */
+    U64(0xB64EC836UL, 0xA47146F9UL), U64(0x9748E282UL, 0x6CDEE284UL),  /* 5^-337 */
+    U64(0xE3E27A44UL, 0x4D8D98B7UL), U64(0xFD1B1B23UL, 0x08169B25UL),  /* 5^-336 */
+    U64(0x8E6D8C6AUL, 0xB0787F72UL), U64(0xFE30F0F5UL, 0xE50E20F7UL),  /* 5^-335 */
+    U64(0xB208EF85UL, 0x5C969F4FUL), U64(0xBDBD2D33UL, 0x5E51A935UL),  /* 5^-334 */
+    U64(0xDE8B2B66UL, 0xB3BC4723UL), U64(0xAD2C7880UL, 0x35E61382UL),  /* 5^-333 */
+    U64(0x8B16FB20UL, 0x3055AC76UL), U64(0x4C3BCB50UL, 0x21AFCC31UL),  /* 5^-332 */
+    U64(0xADDCB9E8UL, 0x3C6B1793UL), U64(0xDF4ABE24UL, 0x2A1BBF3DUL),  /* 5^-331 */
+    U64(0xD953E862UL, 0x4B85DD78UL), U64(0xD71D6DADUL, 0x34A2AF0DUL),  /* 5^-330 */
+    U64(0x87D4713DUL, 0x6F33AA6BUL), U64(0x8672648CUL, 0x40E5AD68UL),  /* 5^-329 */
+    U64(0xA9C98D8CUL, 0xCB009506UL), U64(0x680EFDAFUL, 0x511F18C2UL),  /* 5^-328 */
+    U64(0xD43BF0EFUL, 0xFDC0BA48UL), U64(0x0212BD1BUL, 0x2566DEF2UL),  /* 5^-327 */
+    U64(0x84A57695UL, 0xFE98746DUL), U64(0x014BB630UL, 0xF7604B57UL),  /* 5^-326 */
+    U64(0xA5CED43BUL, 0x7E3E9188UL), U64(0x419EA3BDUL, 0x35385E2DUL),  /* 5^-325 */
+    U64(0xCF42894AUL, 0x5DCE35EAUL), U64(0x52064CACUL, 0x828675B9UL),  /* 5^-324 */
+    U64(0x818995CEUL, 0x7AA0E1B2UL), U64(0x7343EFEBUL, 0xD1940993UL),  /* 5^-323 */
+    U64(0xA1EBFB42UL, 0x19491A1FUL), U64(0x1014EBE6UL, 0xC5F90BF8UL),  /* 5^-322 */
+    U64(0xCA66FA12UL, 0x9F9B60A6UL), U64(0xD41A26E0UL, 0x77774EF6UL),  /* 5^-321 */
+    U64(0xFD00B897UL, 0x478238D0UL), U64(0x8920B098UL, 0x955522B4UL),  /* 5^-320 */
+    U64(0x9E20735EUL, 0x8CB16382UL), U64(0x55B46E5FUL, 0x5D5535B0UL),  /* 5^-319 */
+    U64(0xC5A89036UL, 0x2FDDBC62UL), U64(0xEB2189F7UL, 0x34AA831DUL),  /* 5^-318 */
+    U64(0xF712B443UL, 0xBBD52B7BUL), U64(0xA5E9EC75UL, 0x01D523E4UL),  /* 5^-317 */
+    U64(0x9A6BB0AAUL, 0x55653B2DUL), U64(0x47B233C9UL, 0x2125366EUL),  /* 5^-316 */
+    U64(0xC1069CD4UL, 0xEABE89F8UL), U64(0x999EC0BBUL, 0x696E840AUL),  /* 5^-315 */
+    U64(0xF148440AUL, 0x256E2C76UL), U64(0xC00670EAUL, 0x43CA250DUL),  /* 5^-314 */
+    U64(0x96CD2A86UL, 0x5764DBCAUL), U64(0x38040692UL, 0x6A5E5728UL),  /* 5^-313 */
+    U64(0xBC807527UL, 0xED3E12BCUL), U64(0xC6050837UL, 0x04F5ECF2UL),  /* 5^-312 */
+    U64(0xEBA09271UL, 0xE88D976BUL), U64(0xF7864A44UL, 0xC633682EUL),  /* 5^-311 */
+    U64(0x93445B87UL, 0x31587EA3UL), U64(0x7AB3EE6AUL, 0xFBE0211DUL),  /* 5^-310 */
+    U64(0xB8157268UL, 0xFDAE9E4CUL), U64(0x5960EA05UL, 0xBAD82964UL),  /* 5^-309 */
+    U64(0xE61ACF03UL, 0x3D1A45DFUL), U64(0x6FB92487UL, 0x298E33BDUL),  /* 5^-308 */
+    U64(0x8FD0C162UL, 0x06306BABUL), U64(0xA5D3B6D4UL, 0x79F8E056UL),  /* 5^-307 */
+    U64(0xB3C4F1BAUL, 0x87BC8696UL), U64(0x8F48A489UL, 0x9877186CUL),  /* 5^-306 */
+    U64(0xE0B62E29UL, 0x29ABA83CUL), U64(0x331ACDABUL, 0xFE94DE87UL),  /* 5^-305 */
+    U64(0x8C71DCD9UL, 0xBA0B4925UL), U64(0x9FF0C08BUL, 0x7F1D0B14UL),  /* 5^-304 */
+    U64(0xAF8E5410UL, 0x288E1B6FUL), U64(0x07ECF0AEUL, 0x5EE44DD9UL),  /* 5^-303 */
+    U64(0xDB71E914UL, 0x32B1A24AUL), U64(0xC9E82CD9UL, 0xF69D6150UL),  /* 5^-302 */
+    U64(0x892731ACUL, 0x9FAF056EUL), U64(0xBE311C08UL, 0x3A225CD2UL),  /* 5^-301 */
+    U64(0xAB70FE17UL, 0xC79AC6CAUL), U64(0x6DBD630AUL, 0x48AAF406UL),  /* 5^-300 */
+    U64(0xD64D3D9DUL, 0xB981787DUL), U64(0x092CBBCCUL, 0xDAD5B108UL),  /* 5^-299 */
+    U64(0x85F04682UL, 0x93F0EB4EUL), U64(0x25BBF560UL, 0x08C58EA5UL),  /* 5^-298 */
+    U64(0xA76C5823UL, 0x38ED2621UL), U64(0xAF2AF2B8UL, 0x0AF6F24EUL),  /* 5^-297 */
+    U64(0xD1476E2CUL, 0x07286FAAUL), U64(0x1AF5AF66UL, 0x0DB4AEE1UL),  /* 5^-296 */
+    U64(0x82CCA4DBUL, 0x847945CAUL), U64(0x50D98D9FUL, 0xC890ED4DUL),  /* 5^-295 */
+    U64(0xA37FCE12UL, 0x6597973CUL), U64(0xE50FF107UL, 0xBAB528A0UL),  /* 5^-294 */
+    U64(0xCC5FC196UL, 0xFEFD7D0CUL), U64(0x1E53ED49UL, 0xA96272C8UL),  /* 5^-293 */
+    U64(0xFF77B1FCUL, 0xBEBCDC4FUL), U64(0x25E8E89CUL, 0x13BB0F7AUL),  /* 5^-292 */
+    U64(0x9FAACF3DUL, 0xF73609B1UL), U64(0x77B19161UL, 0x8C54E9ACUL),  /* 5^-291 */
+    U64(0xC795830DUL, 0x75038C1DUL), U64(0xD59DF5B9UL, 0xEF6A2417UL),  /* 5^-290 */
+    U64(0xF97AE3D0UL, 0xD2446F25UL), U64(0x4B057328UL, 0x6B44AD1DUL),  /* 5^-289 */
+    U64(0x9BECCE62UL, 0x836AC577UL), U64(0x4EE367F9UL, 0x430AEC32UL),  /* 5^-288 */
+    U64(0xC2E801FBUL, 0x244576D5UL), U64(0x229C41F7UL, 0x93CDA73FUL),  /* 5^-287 */
+    U64(0xF3A20279UL, 0xED56D48AUL), U64(0x6B435275UL, 0x78C1110FUL),  /* 5^-286 */
+    U64(0x9845418CUL, 0x345644D6UL), U64(0x830A1389UL, 0x6B78AAA9UL),  /* 5^-285 */
+    U64(0xBE5691EFUL, 0x416BD60CUL), U64(0x23CC986BUL, 0xC656D553UL),  /* 5^-284 */
+    U64(0xEDEC366BUL, 0x11C6CB8FUL), U64(0x2CBFBE86UL, 0xB7EC8AA8UL),  /* 5^-283 */
+    U64(0x94B3A202UL, 0xEB1C3F39UL), U64(0x7BF7D714UL, 0x32F3D6A9UL),  /* 5^-282 */
+    U64(0xB9E08A83UL, 0xA5E34F07UL), U64(0xDAF5CCD9UL, 0x3FB0CC53UL),  /* 5^-281 */
+    U64(0xE858AD24UL, 0x8F5C22C9UL), U64(0xD1B3400FUL, 0x8F9CFF68UL),  /* 5^-280 */
+    U64(0x91376C36UL, 0xD99995BEUL), U64(0x23100809UL, 0xB9C21FA1UL),  /* 5^-279 */
+    U64(0xB5854744UL, 0x8FFFFB2DUL), U64(0xABD40A0CUL, 0x2832A78AUL),  /* 5^-278 */
+    U64(0xE2E69915UL, 0xB3FFF9F9UL), U64(0x16C90C8FUL, 0x323F516CUL),  /* 5^-277 */
+    U64(0x8DD01FADUL, 0x907FFC3BUL), U64(0xAE3DA7D9UL, 0x7F6792E3UL),  /* 5^-276 */
+    U64(0xB1442798UL, 0xF49FFB4AUL), U64(0x99CD11CFUL, 0xDF41779CUL),  /* 5^-275 */
+    U64(0xDD95317FUL, 0x31C7FA1DUL), U64(0x40405643UL, 0xD711D583UL),  /* 5^-274 */
+    U64(0x8A7D3EEFUL, 0x7F1CFC52UL), U64(0x482835EAUL, 0x666B2572UL),  /* 5^-273 */
+    U64(0xAD1C8EABUL, 0x5EE43B66UL), U64(0xDA324365UL, 0x0005EECFUL),  /* 5^-272 */
+    U64(0xD863B256UL, 0x369D4A40UL), U64(0x90BED43EUL, 0x40076A82UL),  /* 5^-271 */
+    U64(0x873E4F75UL, 0xE2224E68UL), U64(0x5A7744A6UL, 0xE804A291UL),  /* 5^-270 */
+    U64(0xA90DE353UL, 0x5AAAE202UL), U64(0x711515D0UL, 0xA205CB36UL),  /* 5^-269 */
+    U64(0xD3515C28UL, 0x31559A83UL), U64(0x0D5A5B44UL, 0xCA873E03UL),  /* 5^-268 */
+    U64(0x8412D999UL, 0x1ED58091UL), U64(0xE858790AUL, 0xFE9486C2UL),  /* 5^-267 */
+    U64(0xA5178FFFUL, 0x668AE0B6UL), U64(0x626E974DUL, 0xBE39A872UL),  /* 5^-266 */
+    U64(0xCE5D73FFUL, 0x402D98E3UL), U64(0xFB0A3D21UL, 0x2DC8128FUL),  /* 5^-265 */
+    U64(0x80FA687FUL, 0x881C7F8EUL), U64(0x7CE66634UL, 0xBC9D0B99UL),  /* 5^-264 */
+    U64(0xA139029FUL, 0x6A239F72UL), U64(0x1C1FFFC1UL, 0xEBC44E80UL),  /* 5^-263 */
+    U64(0xC9874347UL, 0x44AC874EUL), U64(0xA327FFB2UL, 0x66B56220UL),  /* 5^-262 */
+    U64(0xFBE91419UL, 0x15D7A922UL), U64(0x4BF1FF9FUL, 0x0062BAA8UL),  /* 5^-261 */
+    U64(0x9D71AC8FUL, 0xADA6C9B5UL), U64(0x6F773FC3UL, 0x603DB4A9UL),  /* 5^-260 */
+    U64(0xC4CE17B3UL, 0x99107C22UL), U64(0xCB550FB4UL, 0x384D21D3UL),  /* 5^-259 */
+    U64(0xF6019DA0UL, 0x7F549B2BUL), U64(0x7E2A53A1UL, 0x46606A48UL),  /* 5^-258 */
+    U64(0x99C10284UL, 0x4F94E0FBUL), U64(0x2EDA7444UL, 0xCBFC426DUL),  /* 5^-257 */
+    U64(0xC0314325UL, 0x637A1939UL), U64(0xFA911155UL, 0xFEFB5308UL),  /* 5^-256 */
+    U64(0xF03D93EEUL, 0xBC589F88UL), U64(0x793555ABUL, 0x7EBA27CAUL),  /* 5^-255 */
+    U64(0x96267C75UL, 0x35B763B5UL), U64(0x4BC1558BUL, 0x2F3458DEUL),  /* 5^-254 */
+    U64(0xBBB01B92UL, 0x83253CA2UL), U64(0x9EB1AAEDUL, 0xFB016F16UL),  /* 5^-253 */
+    U64(0xEA9C2277UL, 0x23EE8BCBUL), U64(0x465E15A9UL, 0x79C1CADCUL),  /* 5^-252 */
+    U64(0x92A1958AUL, 0x7675175FUL), U64(0x0BFACD89UL, 0xEC191EC9UL),  /* 5^-251 */
+    U64(0xB749FAEDUL, 0x14125D36UL), U64(0xCEF980ECUL, 0x671F667BUL),  /* 5^-250 */
+    U64(0xE51C79A8UL, 0x5916F484UL), U64(0x82B7E127UL, 0x80E7401AUL),  /* 5^-249 */
+    U64(0x8F31CC09UL, 0x37AE58D2UL), U64(0xD1B2ECB8UL, 0xB0908810UL),  /* 5^-248 */
+    U64(0xB2FE3F0BUL, 0x8599EF07UL), U64(0x861FA7E6UL, 0xDCB4AA15UL),  /* 5^-247 */
+    U64(0xDFBDCECEUL, 0x67006AC9UL), U64(0x67A791E0UL, 0x93E1D49AUL),  /* 5^-246 */
+    U64(0x8BD6A141UL, 0x006042BDUL), U64(0xE0C8BB2CUL, 0x5C6D24E0UL),  /* 5^-245 */
+    U64(0xAECC4991UL, 0x4078536DUL), U64(0x58FAE9F7UL, 0x73886E18UL),  /* 5^-244 */
+    U64(0xDA7F5BF5UL, 0x90966848UL), U64(0xAF39A475UL, 0x506A899EUL),  /* 5^-243 */
+    U64(0x888F9979UL, 0x7A5E012DUL), U64(0x6D8406C9UL, 0x52429603UL),  /* 5^-242 */
+    U64(0xAAB37FD7UL, 0xD8F58178UL), U64(0xC8E5087BUL, 0xA6D33B83UL),  /* 5^-241 */
+    U64(0xD5605FCDUL, 0xCF32E1D6UL), U64(0xFB1E4A9AUL, 0x90880A64UL),  /* 5^-240 */
+    U64(0x855C3BE0UL, 0xA17FCD26UL), U64(0x5CF2EEA0UL, 0x9A55067FUL),  /* 5^-239 */
+    U64(0xA6B34AD8UL, 0xC9DFC06FUL), U64(0xF42FAA48UL, 0xC0EA481EUL),  /* 5^-238 */
+    U64(0xD0601D8EUL, 0xFC57B08BUL), U64(0xF13B94DAUL, 0xF124DA26UL),  /* 5^-237 */
+    U64(0x823C1279UL, 0x5DB6CE57UL), U64(0x76C53D08UL, 0xD6B70858UL),  /* 5^-236 */
+    U64(0xA2CB1717UL, 0xB52481EDUL), U64(0x54768C4BUL, 0x0C64CA6EUL),  /* 5^-235 */
+    U64(0xCB7DDCDDUL, 0xA26DA268UL), U64(0xA9942F5DUL, 0xCF7DFD09UL),  /* 5^-234 */
+    U64(0xFE5D5415UL, 0x0B090B02UL), U64(0xD3F93B35UL, 0x435D7C4CUL),  /* 5^-233 */
+    U64(0x9EFA548DUL, 0x26E5A6E1UL), U64(0xC47BC501UL, 0x4A1A6DAFUL),  /* 5^-232 */
+    U64(0xC6B8E9B0UL, 0x709F109AUL), U64(0x359AB641UL, 0x9CA1091BUL),  /* 5^-231 */
+    U64(0xF867241CUL, 0x8CC6D4C0UL), U64(0xC30163D2UL, 0x03C94B62UL),  /* 5^-230 */
+    U64(0x9B407691UL, 0xD7FC44F8UL), U64(0x79E0DE63UL, 0x425DCF1DUL),  /* 5^-229 */
+    U64(0xC2109436UL, 0x4DFB5636UL), U64(0x985915FCUL, 0x12F542E4UL),  /* 5^-228 */
+    U64(0xF294B943UL, 0xE17A2BC4UL), U64(0x3E6F5B7BUL, 0x17B2939DUL),  /* 5^-227 */
+    U64(0x979CF3CAUL, 0x6CEC5B5AUL), U64(0xA705992CUL, 0xEECF9C42UL),  /* 5^-226 */
+    U64(0xBD8430BDUL, 0x08277231UL), U64(0x50C6FF78UL, 0x2A838353UL),  /* 5^-225 */
+    U64(0xECE53CECUL, 0x4A314EBDUL), U64(0xA4F8BF56UL, 0x35246428UL),  /* 5^-224 */
+    U64(0x940F4613UL, 0xAE5ED136UL), U64(0x871B7795UL, 0xE136BE99UL),  /* 5^-223 */
+    U64(0xB9131798UL, 0x99F68584UL), U64(0x28E2557BUL, 0x59846E3FUL),  /* 5^-222 */
+    U64(0xE757DD7EUL, 0xC07426E5UL), U64(0x331AEADAUL, 0x2FE589CFUL),  /* 5^-221 */
+    U64(0x9096EA6FUL, 0x3848984FUL), U64(0x3FF0D2C8UL, 0x5DEF7621UL),  /* 5^-220 */
+    U64(0xB4BCA50BUL, 0x065ABE63UL), U64(0x0FED077AUL, 0x756B53A9UL),  /* 5^-219 */
+    U64(0xE1EBCE4DUL, 0xC7F16DFBUL), U64(0xD3E84959UL, 0x12C62894UL),  /* 5^-218 */
+    U64(0x8D3360F0UL, 0x9CF6E4BDUL), U64(0x64712DD7UL, 0xABBBD95CUL),  /* 5^-217 */
+    U64(0xB080392CUL, 0xC4349DECUL), U64(0xBD8D794DUL, 0x96AACFB3UL),  /* 5^-216 */
+    U64(0xDCA04777UL, 0xF541C567UL), U64(0xECF0D7A0UL, 0xFC5583A0UL),  /* 5^-215 */
+    U64(0x89E42CAAUL, 0xF9491B60UL), U64(0xF41686C4UL, 0x9DB57244UL),  /* 5^-214 */
+    U64(0xAC5D37D5UL, 0xB79B6239UL), U64(0x311C2875UL, 0xC522CED5UL),  /* 5^-213 */
+    U64(0xD77485CBUL, 0x25823AC7UL), U64(0x7D633293UL, 0x366B828BUL),  /* 5^-212 */
+    U64(0x86A8D39EUL, 0xF77164BCUL), U64(0xAE5DFF9CUL, 0x02033197UL),  /* 5^-211 */
+    U64(0xA8530886UL, 0xB54DBDEBUL), U64(0xD9F57F83UL, 0x0283FDFCUL),  /* 5^-210 */
+    U64(0xD267CAA8UL, 0x62A12D66UL), U64(0xD072DF63UL, 0xC324FD7BUL),  /* 5^-209 */
+    U64(0x8380DEA9UL, 0x3DA4BC60UL), U64(0x4247CB9EUL, 0x59F71E6DUL),  /* 5^-208 */
+    U64(0xA4611653UL, 0x8D0DEB78UL), U64(0x52D9BE85UL, 0xF074E608UL),  /* 5^-207 */
+    U64(0xCD795BE8UL, 0x70516656UL), U64(0x67902E27UL, 0x6C921F8BUL),  /* 5^-206 */
+    U64(0x806BD971UL, 0x4632DFF6UL), U64(0x00BA1CD8UL, 0xA3DB53B6UL),  /* 5^-205 */
+    U64(0xA086CFCDUL, 0x97BF97F3UL), U64(0x80E8A40EUL, 0xCCD228A4UL),  /* 5^-204 */
+    U64(0xC8A883C0UL, 0xFDAF7DF0UL), U64(0x6122CD12UL, 0x8006B2CDUL),  /* 5^-203 */
+    U64(0xFAD2A4B1UL, 0x3D1B5D6CUL), U64(0x796B8057UL, 0x20085F81UL),  /* 5^-202 */
+    U64(0x9CC3A6EEUL, 0xC6311A63UL), U64(0xCBE33036UL, 0x74053BB0UL),  /* 5^-201 */
+    U64(0xC3F490AAUL, 0x77BD60FCUL), U64(0xBEDBFC44UL, 0x11068A9CUL),  /* 5^-200 */
+    U64(0xF4F1B4D5UL, 0x15ACB93BUL), U64(0xEE92FB55UL, 0x15482D44UL),  /* 5^-199 */
+    U64(0x99171105UL, 0x2D8BF3C5UL), U64(0x751BDD15UL, 0x2D4D1C4AUL),  /* 5^-198 */
+    U64(0xBF5CD546UL, 0x78EEF0B6UL), U64(0xD262D45AUL, 0x78A0635DUL),  /* 5^-197 */
+    U64(0xEF340A98UL, 0x172AACE4UL), U64(0x86FB8971UL, 0x16C87C34UL),  /* 5^-196 */
+    U64(0x9580869FUL, 0x0E7AAC0EUL), U64(0xD45D35E6UL, 0xAE3D4DA0UL),  /* 5^-195 */
+    U64(0xBAE0A846UL, 0xD2195712UL), U64(0x89748360UL, 0x59CCA109UL),  /* 5^-194 */
+    U64(0xE998D258UL, 0x869FACD7UL), U64(0x2BD1A438UL, 0x703FC94BUL),  /* 5^-193 */
+    U64(0x91FF8377UL, 0x5423CC06UL), U64(0x7B6306A3UL, 0x4627DDCFUL),  /* 5^-192 */
+    U64(0xB67F6455UL, 0x292CBF08UL), U64(0x1A3BC84CUL, 0x17B1D542UL),  /* 5^-191 */
+    U64(0xE41F3D6AUL, 0x7377EECAUL), U64(0x20CABA5FUL, 0x1D9E4A93UL),  /* 5^-190 */
+    U64(0x8E938662UL, 0x882AF53EUL), U64(0x547EB47BUL, 0x7282EE9CUL),  /* 5^-189 */
+    U64(0xB23867FBUL, 0x2A35B28DUL), U64(0xE99E619AUL, 0x4F23AA43UL),  /* 5^-188 */
+    U64(0xDEC681F9UL, 0xF4C31F31UL), U64(0x6405FA00UL, 0xE2EC94D4UL),  /* 5^-187 */
+    U64(0x8B3C113CUL, 0x38F9F37EUL), U64(0xDE83BC40UL, 0x8DD3DD04UL),  /* 5^-186 */
+    U64(0xAE0B158BUL, 0x4738705EUL), U64(0x9624AB50UL, 0xB148D445UL),  /* 5^-185 */
+    U64(0xD98DDAEEUL, 0x19068C76UL), U64(0x3BADD624UL, 0xDD9B0957UL),  /* 5^-184 */
+    U64(0x87F8A8D4UL, 0xCFA417C9UL), U64(0xE54CA5D7UL, 0x0A80E5D6UL),  /* 5^-183 */
+    U64(0xA9F6D30AUL, 0x038D1DBCUL), U64(0x5E9FCF4CUL, 0xCD211F4CUL),  /* 5^-182 */
+    U64(0xD47487CCUL, 0x8470652BUL), U64(0x7647C320UL, 0x0069671FUL),  /* 5^-181 */
+    U64(0x84C8D4DFUL, 0xD2C63F3BUL), U64(0x29ECD9F4UL, 0x0041E073UL),  /* 5^-180 */
+    U64(0xA5FB0A17UL, 0xC777CF09UL), U64(0xF4681071UL, 0x00525890UL),  /* 5^-179 */
+    U64(0xCF79CC9DUL, 0xB955C2CCUL), U64(0x7182148DUL, 0x4066EEB4UL),  /* 5^-178 */
+    U64(0x81AC1FE2UL, 0x93D599BFUL), U64(0xC6F14CD8UL, 0x48405530UL),  /* 5^-177 */
+    U64(0xA21727DBUL, 0x38CB002FUL), U64(0xB8ADA00EUL, 0x5A506A7CUL),  /* 5^-176 */
+    U64(0xCA9CF1D2UL, 0x06FDC03BUL), U64(0xA6D90811UL, 0xF0E4851CUL),  /* 5^-175 */
+    U64(0xFD442E46UL, 0x88BD304AUL), U64(0x908F4A16UL, 0x6D1DA663UL),  /* 5^-174 */
+    U64(0x9E4A9CECUL, 0x15763E2EUL), U64(0x9A598E4EUL, 0x043287FEUL),  /* 5^-173 */
+    U64(0xC5DD4427UL, 0x1AD3CDBAUL), U64(0x40EFF1E1UL, 0x853F29FDUL),  /* 5^-172 */
+    U64(0xF7549530UL, 0xE188C128UL), U64(0xD12BEE59UL, 0xE68EF47CUL),  /* 5^-171 */
+    U64(0x9A94DD3EUL, 0x8CF578B9UL), U64(0x82BB74F8UL, 0x301958CEUL),  /* 5^-170 */
+    U64(0xC13A148EUL, 0x3032D6E7UL), U64(0xE36A5236UL, 0x3C1FAF01UL),  /* 5^-169 */
+    U64(0xF18899B1UL, 0xBC3F8CA1UL), U64(0xDC44E6C3UL, 0xCB279AC1UL),  /* 5^-168 */
+    U64(0x96F5600FUL, 0x15A7B7E5UL), U64(0x29AB103AUL, 0x5EF8C0B9UL),  /* 5^-167 */
+    U64(0xBCB2B812UL, 0xDB11A5DEUL), U64(0x7415D448UL, 0xF6B6F0E7UL),  /* 5^-166 */
+    U64(0xEBDF6617UL, 0x91D60F56UL), U64(0x111B495BUL, 0x3464AD21UL),  /* 5^-165 */
+    U64(0x936B9FCEUL, 0xBB25C995UL), U64(0xCAB10DD9UL, 0x00BEEC34UL),  /* 5^-164 */
+    U64(0xB84687C2UL, 0x69EF3BFBUL), U64(0x3D5D514FUL, 0x40EEA742UL),  /* 5^-163 */
+    U64(0xE65829B3UL, 0x046B0AFAUL), U64(0x0CB4A5A3UL, 0x112A5112UL),  /* 5^-162 */
+    U64(0x8FF71A0FUL, 0xE2C2E6DCUL), U64(0x47F0E785UL, 0xEABA72ABUL),  /* 5^-161 */
+    U64(0xB3F4E093UL, 0xDB73A093UL), U64(0x59ED2167UL, 0x65690F56UL),  /* 5^-160 */
+    U64(0xE0F218B8UL, 0xD25088B8UL), U64(0x306869C1UL, 0x3EC3532CUL),  /* 5^-159 */
+    U64(0x8C974F73UL, 0x83725573UL), U64(0x1E414218UL, 0xC73A13FBUL),  /* 5^-158 */
+    U64(0xAFBD2350UL, 0x644EEACFUL), U64(0xE5D1929EUL, 0xF90898FAUL),  /* 5^-157 */
+    U64(0xDBAC6C24UL, 0x7D62A583UL), U64(0xDF45F746UL, 0xB74ABF39UL),  /* 5^-156 */
+    U64(0x894BC396UL, 0xCE5DA772UL), U64(0x6B8BBA8CUL, 0x328EB783UL),  /* 5^-155 */
+    U64(0xAB9EB47CUL, 0x81F5114FUL), U64(0x066EA92FUL, 0x3F326564UL),  /* 5^-154 */
+    U64(0xD686619BUL, 0xA27255A2UL), U64(0xC80A537BUL, 0x0EFEFEBDUL),  /* 5^-153 */
+    U64(0x8613FD01UL, 0x45877585UL), U64(0xBD06742CUL, 0xE95F5F36UL),  /* 5^-152 */
+    U64(0xA798FC41UL, 0x96E952E7UL), U64(0x2C481138UL, 0x23B73704UL),  /* 5^-151 */
+    U64(0xD17F3B51UL, 0xFCA3A7A0UL), U64(0xF75A1586UL, 0x2CA504C5UL),  /* 5^-150 */
+    U64(0x82EF8513UL, 0x3DE648C4UL), U64(0x9A984D73UL, 0xDBE722FBUL),  /* 5^-149 */
+    U64(0xA3AB6658UL, 0x0D5FDAF5UL), U64(0xC13E60D0UL, 0xD2E0EBBAUL),  /* 5^-148 */
+    U64(0xCC963FEEUL, 0x10B7D1B3UL), U64(0x318DF905UL, 0x079926A8UL),  /* 5^-147 */
+    U64(0xFFBBCFE9UL, 0x94E5C61FUL), U64(0xFDF17746UL, 0x497F7052UL),  /* 5^-146 */
+    U64(0x9FD561F1UL, 0xFD0F9BD3UL), U64(0xFEB6EA8BUL, 0xEDEFA633UL),  /* 5^-145 */
+    U64(0xC7CABA6EUL, 0x7C5382C8UL), U64(0xFE64A52EUL, 0xE96B8FC0UL),  /* 5^-144 */
+    U64(0xF9BD690AUL, 0x1B68637BUL), U64(0x3DFDCE7AUL, 0xA3C673B0UL),  /* 5^-143 */
+    U64(0x9C1661A6UL, 0x51213E2DUL), U64(0x06BEA10CUL, 0xA65C084EUL),  /* 5^-142 */
+    U64(0xC31BFA0FUL, 0xE5698DB8UL), U64(0x486E494FUL, 0xCFF30A62UL),  /* 5^-141 */
+    U64(0xF3E2F893UL, 0xDEC3F126UL), U64(0x5A89DBA3UL, 0xC3EFCCFAUL),  /* 5^-140 */
+    U64(0x986DDB5CUL, 0x6B3A76B7UL), U64(0xF8962946UL, 0x5A75E01CUL),  /* 5^-139 */
+    U64(0xBE895233UL, 0x86091465UL), U64(0xF6BBB397UL, 0xF1135823UL),  /* 5^-138 */
+    U64(0xEE2BA6C0UL, 0x678B597FUL), U64(0x746AA07DUL, 0xED582E2CUL),  /* 5^-137 */
+    U64(0x94DB4838UL, 0x40B717EFUL), U64(0xA8C2A44EUL, 0xB4571CDCUL),  /* 5^-136 */
+    U64(0xBA121A46UL, 0x50E4DDEBUL), U64(0x92F34D62UL, 0x616CE413UL),  /* 5^-135 */
+    U64(0xE896A0D7UL, 0xE51E1566UL), U64(0x77B020BAUL, 0xF9C81D17UL),  /* 5^-134 */
+    U64(0x915E2486UL, 0xEF32CD60UL), U64(0x0ACE1474UL, 0xDC1D122EUL),  /* 5^-133 */
+    U64(0xB5B5ADA8UL, 0xAAFF80B8UL), U64(0x0D819992UL, 0x132456BAUL),  /* 5^-132 */
+    U64(0xE3231912UL, 0xD5BF60E6UL), U64(0x10E1FFF6UL, 0x97ED6C69UL),  /* 5^-131 */
+    U64(0x8DF5EFABUL, 0xC5979C8FUL), U64(0xCA8D3FFAUL, 0x1EF463C1UL),  /* 5^-130 */
+    U64(0xB1736B96UL, 0xB6FD83B3UL), U64(0xBD308FF8UL, 0xA6B17CB2UL),  /* 5^-129 */
+    U64(0xDDD0467CUL, 0x64BCE4A0UL), U64(0xAC7CB3F6UL, 0xD05DDBDEUL),  /* 5^-128 */
+    U64(0x8AA22C0DUL, 0xBEF60EE4UL), U64(0x6BCDF07AUL, 0x423AA96BUL),  /* 5^-127 */
+    U64(0xAD4AB711UL, 0x2EB3929DUL), U64(0x86C16C98UL, 0xD2C953C6UL),  /* 5^-126 */
+    U64(0xD89D64D5UL, 0x7A607744UL), U64(0xE871C7BFUL, 0x077BA8B7UL),  /* 5^-125 */
+    U64(0x87625F05UL, 0x6C7C4A8BUL), U64(0x11471CD7UL, 0x64AD4972UL),  /* 5^-124 */
+    U64(0xA93AF6C6UL, 0xC79B5D2DUL), U64(0xD598E40DUL, 0x3DD89BCFUL),  /* 5^-123 */
+    U64(0xD389B478UL, 0x79823479UL), U64(0x4AFF1D10UL, 0x8D4EC2C3UL),  /* 5^-122 */
+    U64(0x843610CBUL, 0x4BF160CBUL), U64(0xCEDF722AUL, 0x585139BAUL),  /* 5^-121 */
+    U64(0xA54394FEUL, 0x1EEDB8FEUL), U64(0xC2974EB4UL, 0xEE658828UL),  /* 5^-120 */
+    U64(0xCE947A3DUL, 0xA6A9273EUL), U64(0x733D2262UL, 0x29FEEA32UL),  /* 5^-119 */
+    U64(0x811CCC66UL, 0x8829B887UL), U64(0x0806357DUL, 0x5A3F525FUL),  /* 5^-118 */
+    U64(0xA163FF80UL, 0x2A3426A8UL), U64(0xCA07C2DCUL, 0xB0CF26F7UL),  /* 5^-117 */
+    U64(0xC9BCFF60UL, 0x34C13052UL), U64(0xFC89B393UL, 0xDD02F0B5UL),  /* 5^-116 */
+    U64(0xFC2C3F38UL, 0x41F17C67UL), U64(0xBBAC2078UL, 0xD443ACE2UL),  /* 5^-115 */
+    U64(0x9D9BA783UL, 0x2936EDC0UL), U64(0xD54B944BUL, 0x84AA4C0DUL),  /* 5^-114 */
+    U64(0xC5029163UL, 0xF384A931UL), U64(0x0A9E795EUL, 0x65D4DF11UL),  /* 5^-113 */
+    U64(0xF64335BCUL, 0xF065D37DUL), U64(0x4D4617B5UL, 0xFF4A16D5UL),  /* 5^-112 */
+    U64(0x99EA0196UL, 0x163FA42EUL), U64(0x504BCED1UL, 0xBF8E4E45UL),  /* 5^-111 */
+    U64(0xC06481FBUL, 0x9BCF8D39UL), U64(0xE45EC286UL, 0x2F71E1D6UL),  /* 5^-110 */
+    U64(0xF07DA27AUL, 0x82C37088UL), U64(0x5D767327UL, 0xBB4E5A4CUL),  /* 5^-109 */
+    U64(0x964E858CUL, 0x91BA2655UL), U64(0x3A6A07F8UL, 0xD510F86FUL),  /* 5^-108 */
+    U64(0xBBE226EFUL, 0xB628AFEAUL), U64(0x890489F7UL, 0x0A55368BUL),  /* 5^-107 */
+    U64(0xEADAB0ABUL, 0xA3B2DBE5UL), U64(0x2B45AC74UL, 0xCCEA842EUL),  /* 5^-106 */
+    U64(0x92C8AE6BUL, 0x464FC96FUL), U64(0x3B0B8BC9UL, 0x0012929DUL),  /* 5^-105 */
+    U64(0xB77ADA06UL, 0x17E3BBCBUL), U64(0x09CE6EBBUL, 0x40173744UL),  /* 5^-104 */
+    U64(0xE5599087UL, 0x9DDCAABDUL), U64(0xCC420A6AUL, 0x101D0515UL),  /* 5^-103 */
+    U64(0x8F57FA54UL, 0xC2A9EAB6UL), U64(0x9FA94682UL, 0x4A12232DUL),  /* 5^-102 */
+    U64(0xB32DF8E9UL, 0xF3546564UL), U64(0x47939822UL, 0xDC96ABF9UL),  /* 5^-101 */
+    U64(0xDFF97724UL, 0x70297EBDUL), U64(0x59787E2BUL, 0x93BC56F7UL),  /* 5^-100 */
+    U64(0x8BFBEA76UL, 0xC619EF36UL), U64(0x57EB4EDBUL, 0x3C55B65AUL),  /* 5^-99 */
+    U64(0xAEFAE514UL, 0x77A06B03UL), U64(0xEDE62292UL, 0x0B6B23F1UL),  /* 5^-98 */
+    U64(0xDAB99E59UL, 0x958885C4UL), U64(0xE95FAB36UL, 0x8E45ECEDUL),  /* 5^-97 */
+    U64(0x88B402F7UL, 0xFD75539BUL), U64(0x11DBCB02UL, 0x18EBB414UL),  /* 5^-96 */
+    U64(0xAAE103B5UL, 0xFCD2A881UL), U64(0xD652BDC2UL, 0x9F26A119UL),  /* 5^-95 */
+    U64(0xD59944A3UL, 0x7C0752A2UL), U64(0x4BE76D33UL, 0x46F0495FUL),  /* 5^-94 */
+    U64(0x857FCAE6UL, 0x2D8493A5UL), U64(0x6F70A440UL, 0x0C562DDBUL),  /* 5^-93 */
+    U64(0xA6DFBD9FUL, 0xB8E5B88EUL), U64(0xCB4CCD50UL, 0x0F6BB952UL),  /* 5^-92 */
+    U64(0xD097AD07UL, 0xA71F26B2UL), U64(0x7E2000A4UL, 0x1346A7A7UL),  /* 5^-91 */
+    U64(0x825ECC24UL, 0xC873782FUL), U64(0x8ED40066UL, 0x8C0C28C8UL),  /* 5^-90 */
+    U64(0xA2F67F2DUL, 0xFA90563BUL), U64(0x72890080UL, 0x2F0F32FAUL),  /* 5^-89 */
+    U64(0xCBB41EF9UL, 0x79346BCAUL), U64(0x4F2B40A0UL, 0x3AD2FFB9UL),  /* 5^-88 */
+    U64(0xFEA126B7UL, 0xD78186BCUL), U64(0xE2F610C8UL, 0x4987BFA8UL),  /* 5^-87 */
+    U64(0x9F24B832UL, 0xE6B0F436UL), U64(0x0DD9CA7DUL, 0x2DF4D7C9UL),  /* 5^-86 */
+    U64(0xC6EDE63FUL, 0xA05D3143UL), U64(0x91503D1CUL, 0x79720DBBUL),  /* 5^-85 */
+    U64(0xF8A95FCFUL, 0x88747D94UL), U64(0x75A44C63UL, 0x97CE912AUL),  /* 5^-84 */
+    U64(0x9B69DBE1UL, 0xB548CE7CUL), U64(0xC986AFBEUL, 0x3EE11ABAUL),  /* 5^-83 */
+    U64(0xC24452DAUL, 0x229B021BUL), U64(0xFBE85BADUL, 0xCE996168UL),  /* 5^-82 */
+    U64(0xF2D56790UL, 0xAB41C2A2UL), U64(0xFAE27299UL, 0x423FB9C3UL),  /* 5^-81 */
+    U64(0x97C560BAUL, 0x6B0919A5UL), U64(0xDCCD879FUL, 0xC967D41AUL),  /* 5^-80 */
+    U64(0xBDB6B8E9UL, 0x05CB600FUL), U64(0x5400E987UL, 0xBBC1C920UL),  /* 5^-79 */
+    U64(0xED246723UL, 0x473E3813UL), U64(0x290123E9UL, 0xAAB23B68UL),  /* 5^-78 */
+    U64(0x9436C076UL, 0x0C86E30BUL), U64(0xF9A0B672UL, 0x0AAF6521UL),  /* 5^-77 */
+    U64(0xB9447093UL, 0x8FA89BCEUL), U64(0xF808E40EUL, 0x8D5B3E69UL),  /* 5^-76 */
+    U64(0xE7958CB8UL, 0x7392C2C2UL), U64(0xB60B1D12UL, 0x30B20E04UL),  /* 5^-75 */
+    U64(0x90BD77F3UL, 0x483BB9B9UL), U64(0xB1C6F22BUL, 0x5E6F48C2UL),  /* 5^-74 */
+    U64(0xB4ECD5F0UL, 0x1A4AA828UL), U64(0x1E38AEB6UL, 0x360B1AF3UL),  /* 5^-73 */
+    U64(0xE2280B6CUL, 0x20DD5232UL), U64(0x25C6DA63UL, 0xC38DE1B0UL),  /* 5^-72 */
+    U64(0x8D590723UL, 0x948A535FUL), U64(0x579C487EUL, 0x5A38AD0EUL),  /* 5^-71 */
+    U64(0xB0AF48ECUL, 0x79ACE837UL), U64(0x2D835A9DUL, 0xF0C6D851UL),  /* 5^-70 */
+    U64(0xDCDB1B27UL, 0x98182244UL), U64(0xF8E43145UL, 0x6CF88E65UL),  /* 5^-69 */
+    U64(0x8A08F0F8UL, 0xBF0F156BUL), U64(0x1B8E9ECBUL, 0x641B58FFUL),  /* 5^-68 */
+    U64(0xAC8B2D36UL, 0xEED2DAC5UL), U64(0xE272467EUL, 0x3D222F3FUL),  /* 5^-67 */
+    U64(0xD7ADF884UL, 0xAA879177UL), U64(0x5B0ED81DUL, 0xCC6ABB0FUL),  /* 5^-66 */
+    U64(0x86CCBB52UL, 0xEA94BAEAUL), U64(0x98E94712UL, 0x9FC2B4E9UL),  /* 5^-65 */
+    U64(0xA87FEA27UL, 0xA539E9A5UL), U64(0x3F2398D7UL, 0x47B36224UL),  /* 5^-64 */
+    U64(0xD29FE4B1UL, 0x8E88640EUL), U64(0x8EEC7F0DUL, 0x19A03AADUL),  /* 5^-63 */
+    U64(0x83A3EEEEUL, 0xF9153E89UL), U64(0x1953CF68UL, 0x300424ACUL),  /* 5^-62 */
+    U64(0xA48CEAAAUL, 0xB75A8E2BUL), U64(0x5FA8C342UL, 0x3C052DD7UL),  /* 5^-61 */
+    U64(0xCDB02555UL, 0x653131B6UL), U64(0x3792F412UL, 0xCB06794DUL),  /* 5^-60 */
+    U64(0x808E1755UL, 0x5F3EBF11UL), U64(0xE2BBD88BUL, 0xBEE40BD0UL),  /* 5^-59 */
+    U64(0xA0B19D2AUL, 0xB70E6ED6UL), U64(0x5B6ACEAEUL, 0xAE9D0EC4UL),  /* 5^-58 */
+    U64(0xC8DE0475UL, 0x64D20A8BUL), U64(0xF245825AUL, 0x5A445275UL),  /* 5^-57 */
+    U64(0xFB158592UL, 0xBE068D2EUL), U64(0xEED6E2F0UL, 0xF0D56712UL),  /* 5^-56 */
+    U64(0x9CED737BUL, 0xB6C4183DUL), U64(0x55464DD6UL, 0x9685606BUL),  /* 5^-55 */
+    U64(0xC428D05AUL, 0xA4751E4CUL), U64(0xAA97E14CUL, 0x3C26B886UL),  /* 5^-54 */
+    U64(0xF5330471UL, 0x4D9265DFUL), U64(0xD53DD99FUL, 0x4B3066A8UL),  /* 5^-53 */
+    U64(0x993FE2C6UL, 0xD07B7FABUL), U64(0xE546A803UL, 0x8EFE4029UL),  /* 5^-52 */
+    U64(0xBF8FDB78UL, 0x849A5F96UL), U64(0xDE985204UL, 0x72BDD033UL),  /* 5^-51 */
+    U64(0xEF73D256UL, 0xA5C0F77CUL), U64(0x963E6685UL, 0x8F6D4440UL),  /* 5^-50 */
+    U64(0x95A86376UL, 0x27989AADUL), U64(0xDDE70013UL, 0x79A44AA8UL),  /* 5^-49 */
+    U64(0xBB127C53UL, 0xB17EC159UL), U64(0x5560C018UL, 0x580D5D52UL),  /* 5^-48 */
+    U64(0xE9D71B68UL, 0x9DDE71AFUL), U64(0xAAB8F01EUL, 0x6E10B4A6UL),  /* 5^-47 */
+    U64(0x92267121UL, 0x62AB070DUL), U64(0xCAB39613UL, 0x04CA70E8UL),  /* 5^-46 */
+    U64(0xB6B00D69UL, 0xBB55C8D1UL), U64(0x3D607B97UL, 0xC5FD0D22UL),  /* 5^-45 */
+    U64(0xE45C10C4UL, 0x2A2B3B05UL), U64(0x8CB89A7DUL, 0xB77C506AUL),  /* 5^-44 */
+    U64(0x8EB98A7AUL, 0x9A5B04E3UL), U64(0x77F3608EUL, 0x92ADB242UL),  /* 5^-43 */
+    U64(0xB267ED19UL, 0x40F1C61CUL), U64(0x55F038B2UL, 0x37591ED3UL),  /* 5^-42 */
+    U64(0xDF01E85FUL, 0x912E37A3UL), U64(0x6B6C46DEUL, 0xC52F6688UL),  /* 5^-41 */
+    U64(0x8B61313BUL, 0xBABCE2C6UL), U64(0x2323AC4BUL, 0x3B3DA015UL),  /* 5^-40 */
+    U64(0xAE397D8AUL, 0xA96C1B77UL), U64(0xABEC975EUL, 0x0A0D081AUL),  /* 5^-39 */
+    U64(0xD9C7DCEDUL, 0x53C72255UL), U64(0x96E7BD35UL, 0x8C904A21UL),  /* 5^-38 */
+    U64(0x881CEA14UL, 0x545C7575UL), U64(0x7E50D641UL, 0x77DA2E54UL),  /* 5^-37 */
+    U64(0xAA242499UL, 0x697392D2UL), U64(0xDDE50BD1UL, 0xD5D0B9E9UL),  /* 5^-36 */
+    U64(0xD4AD2DBFUL, 0xC3D07787UL), U64(0x955E4EC6UL, 0x4B44E864UL),  /* 5^-35 */
+    U64(0x84EC3C97UL, 0xDA624AB4UL), U64(0xBD5AF13BUL, 0xEF0B113EUL),  /* 5^-34 */
+    U64(0xA6274BBDUL, 0xD0FADD61UL), U64(0xECB1AD8AUL, 0xEACDD58EUL),  /* 5^-33 */
+    U64(0xCFB11EADUL, 0x453994BAUL), U64(0x67DE18EDUL, 0xA5814AF2UL),  /* 5^-32 */
+    U64(0x81CEB32CUL, 0x4B43FCF4UL), U64(0x80EACF94UL, 0x8770CED7UL),  /* 5^-31 */
+    U64(0xA2425FF7UL, 0x5E14FC31UL), U64(0xA1258379UL, 0xA94D028DUL),  /* 5^-30 */
+    U64(0xCAD2F7F5UL, 0x359A3B3EUL), U64(0x096EE458UL, 0x13A04330UL),  /* 5^-29 */
+    U64(0xFD87B5F2UL, 0x8300CA0DUL), U64(0x8BCA9D6EUL, 0x188853FCUL),  /* 5^-28 */
+    U64(0x9E74D1B7UL, 0x91E07E48UL), U64(0x775EA264UL, 0xCF55347EUL),  /* 5^-27 */
+    U64(0xC6120625UL, 0x76589DDAUL), U64(0x95364AFEUL, 0x032A819EUL),  /* 5^-26 */
+    U64(0xF79687AEUL, 0xD3EEC551UL), U64(0x3A83DDBDUL, 0x83F52205UL),  /* 5^-25 */
+    U64(0x9ABE14CDUL, 0x44753B52UL), U64(0xC4926A96UL, 0x72793543UL),  /* 5^-24 */
+    U64(0xC16D9A00UL, 0x95928A27UL), U64(0x75B7053CUL, 0x0F178294UL),  /* 5^-23 */
+    U64(0xF1C90080UL, 0xBAF72CB1UL), U64(0x5324C68BUL, 0x12DD6339UL),  /* 5^-22 */
+    U64(0x971DA050UL, 0x74DA7BEEUL), U64(0xD3F6FC16UL, 0xEBCA5E04UL),  /* 5^-21 */
+    U64(0xBCE50864UL, 0x92111AEAUL), U64(0x88F4BB1CUL, 0xA6BCF585UL),  /* 5^-20 */
+    U64(0xEC1E4A7DUL, 0xB69561A5UL), U64(0x2B31E9E3UL, 0xD06C32E6UL),  /* 5^-19 */
+    U64(0x9392EE8EUL, 0x921D5D07UL), U64(0x3AFF322EUL, 0x62439FD0UL),  /* 5^-18 */
+    U64(0xB877AA32UL, 0x36A4B449UL), U64(0x09BEFEB9UL, 0xFAD487C3UL),  /* 5^-17 */
+    U64(0xE69594BEUL, 0xC44DE15BUL), U64(0x4C2EBE68UL, 0x7989A9B4UL),  /* 5^-16 */
+    U64(0x901D7CF7UL, 0x3AB0ACD9UL), U64(0x0F9D3701UL, 0x4BF60A11UL),  /* 5^-15 */
+    U64(0xB424DC35UL, 0x095CD80FUL), U64(0x538484C1UL, 0x9EF38C95UL),  /* 5^-14 */
+    U64(0xE12E1342UL, 0x4BB40E13UL), U64(0x2865A5F2UL, 0x06B06FBAUL),  /* 5^-13 */
+    U64(0x8CBCCC09UL, 0x6F5088CBUL), U64(0xF93F87B7UL, 0x442E45D4UL),  /* 5^-12 */
+    U64(0xAFEBFF0BUL, 0xCB24AAFEUL), U64(0xF78F69A5UL, 0x1539D749UL),  /* 5^-11 */
+    U64(0xDBE6FECEUL, 0xBDEDD5BEUL), U64(0xB573440EUL, 0x5A884D1CUL),  /* 5^-10 */
+    U64(0x89705F41UL, 0x36B4A597UL), U64(0x31680A88UL, 0xF8953031UL),  /* 5^-9 */
+    U64(0xABCC7711UL, 0x8461CEFCUL), U64(0xFDC20D2BUL, 0x36BA7C3EUL),  /* 5^-8 */
+    U64(0xD6BF94D5UL, 0xE57A42BCUL), U64(0x3D329076UL, 0x04691B4DUL),  /* 5^-7 */
+    U64(0x8637BD05UL, 0xAF6C69B5UL), U64(0xA63F9A49UL, 0xC2C1B110UL),  /* 5^-6 */
+    U64(0xA7C5AC47UL, 0x1B478423UL), U64(0x0FCF80DCUL, 0x33721D54UL),  /* 5^-5 */
+    U64(0xD1B71758UL, 0xE219652BUL), U64(0xD3C36113UL, 0x404EA4A9UL),  /* 5^-4 */
+    U64(0x83126E97UL, 0x8D4FDF3BUL), U64(0x645A1CACUL, 0x083126EAUL),  /* 5^-3 */
+    U64(0xA3D70A3DUL, 0x70A3D70AUL), U64(0x3D70A3D7UL, 0x0A3D70A4UL),  /* 5^-2 */
+    U64(0xCCCCCCCCUL, 0xCCCCCCCCUL), U64(0xCCCCCCCCUL, 0xCCCCCCCDUL),  /* 5^-1 */
+    U64(0x80000000UL, 0x00000000UL), U64(0x00000000UL, 0x00000000UL),  /* 5^0 */
+    U64(0xA0000000UL, 0x00000000UL), U64(0x00000000UL, 0x00000000UL),  /* 5^1 */
+    U64(0xC8000000UL, 0x00000000UL), U64(0x00000000UL, 0x00000000UL),  /* 5^2 */
+    U64(0xFA000000UL, 0x00000000UL), U64(0x00000000UL, 0x00000000UL),  /* 5^3 */
+    U64(0x9C400000UL, 0x00000000UL), U64(0x00000000UL, 0x00000000UL),  /* 5^4 */
+    U64(0xC3500000UL, 0x00000000UL), U64(0x00000000UL, 0x00000000UL),  /* 5^5 */
+    U64(0xF4240000UL, 0x00000000UL), U64(0x00000000UL, 0x00000000UL),  /* 5^6 */
+    U64(0x98968000UL, 0x00000000UL), U64(0x00000000UL, 0x00000000UL),  /* 5^7 */
+    U64(0xBEBC2000UL, 0x00000000UL), U64(0x00000000UL, 0x00000000UL),  /* 5^8 */
+    U64(0xEE6B2800UL, 0x00000000UL), U64(0x00000000UL, 0x00000000UL),  /* 5^9 */
+    U64(0x9502F900UL, 0x00000000UL), U64(0x00000000UL, 0x00000000UL),  /* 5^10 */
+    U64(0xBA43B740UL, 0x00000000UL), U64(0x00000000UL, 0x00000000UL),  /* 5^11 */
+    U64(0xE8D4A510UL, 0x00000000UL), U64(0x00000000UL, 0x00000000UL),  /* 5^12 */
+    U64(0x9184E72AUL, 0x00000000UL), U64(0x00000000UL, 0x00000000UL),  /* 5^13 */
+    U64(0xB5E620F4UL, 0x80000000UL), U64(0x00000000UL, 0x00000000UL),  /* 5^14 */
+    U64(0xE35FA931UL, 0xA0000000UL), U64(0x00000000UL, 0x00000000UL),  /* 5^15 */
+    U64(0x8E1BC9BFUL, 0x04000000UL), U64(0x00000000UL, 0x00000000UL),  /* 5^16 */
+    U64(0xB1A2BC2EUL, 0xC5000000UL), U64(0x00000000UL, 0x00000000UL),  /* 5^17 */
+    U64(0xDE0B6B3AUL, 0x76400000UL), U64(0x00000000UL, 0x00000000UL),  /* 5^18 */
+    U64(0x8AC72304UL, 0x89E80000UL), U64(0x00000000UL, 0x00000000UL),  /* 5^19 */
+    U64(0xAD78EBC5UL, 0xAC620000UL), U64(0x00000000UL, 0x00000000UL),  /* 5^20 */
+    U64(0xD8D726B7UL, 0x177A8000UL), U64(0x00000000UL, 0x00000000UL),  /* 5^21 */
+    U64(0x87867832UL, 0x6EAC9000UL), U64(0x00000000UL, 0x00000000UL),  /* 5^22 */
+    U64(0xA968163FUL, 0x0A57B400UL), U64(0x00000000UL, 0x00000000UL),  /* 5^23 */
+    U64(0xD3C21BCEUL, 0xCCEDA100UL), U64(0x00000000UL, 0x00000000UL),  /* 5^24 */
+    U64(0x84595161UL, 0x401484A0UL), U64(0x00000000UL, 0x00000000UL),  /* 5^25 */
+    U64(0xA56FA5B9UL, 0x9019A5C8UL), U64(0x00000000UL, 0x00000000UL),  /* 5^26 */
+    U64(0xCECB8F27UL, 0xF4200F3AUL), U64(0x00000000UL, 0x00000000UL),  /* 5^27 */
+    U64(0x813F3978UL, 0xF8940984UL), U64(0x40000000UL, 0x00000000UL),  /* 5^28 */
+    U64(0xA18F07D7UL, 0x36B90BE5UL), U64(0x50000000UL, 0x00000000UL),  /* 5^29 */
+    U64(0xC9F2C9CDUL, 0x04674EDEUL), U64(0xA4000000UL, 0x00000000UL),  /* 5^30 */
+    U64(0xFC6F7C40UL, 0x45812296UL), U64(0x4D000000UL, 0x00000000UL),  /* 5^31 */
+    U64(0x9DC5ADA8UL, 0x2B70B59DUL), U64(0xF0200000UL, 0x00000000UL),  /* 5^32 */
+    U64(0xC5371912UL, 0x364CE305UL), U64(0x6C280000UL, 0x00000000UL),  /* 5^33 */
+    U64(0xF684DF56UL, 0xC3E01BC6UL), U64(0xC7320000UL, 0x00000000UL),  /* 5^34 */
+    U64(0x9A130B96UL, 0x3A6C115CUL), U64(0x3C7F4000UL, 0x00000000UL),  /* 5^35 */
+    U64(0xC097CE7BUL, 0xC90715B3UL), U64(0x4B9F1000UL, 0x00000000UL),  /* 5^36 */
+    U64(0xF0BDC21AUL, 0xBB48DB20UL), U64(0x1E86D400UL, 0x00000000UL),  /* 5^37 */
+    U64(0x96769950UL, 0xB50D88F4UL), U64(0x13144480UL, 0x00000000UL),  /* 5^38 */
+    U64(0xBC143FA4UL, 0xE250EB31UL), U64(0x17D955A0UL, 0x00000000UL),  /* 5^39 */
+    U64(0xEB194F8EUL, 0x1AE525FDUL), U64(0x5DCFAB08UL, 0x00000000UL),  /* 5^40 */
+    U64(0x92EFD1B8UL, 0xD0CF37BEUL), U64(0x5AA1CAE5UL, 0x00000000UL),  /* 5^41 */
+    U64(0xB7ABC627UL, 0x050305ADUL), U64(0xF14A3D9EUL, 0x40000000UL),  /* 5^42 */
+    U64(0xE596B7B0UL, 0xC643C719UL), U64(0x6D9CCD05UL, 0xD0000000UL),  /* 5^43 */
+    U64(0x8F7E32CEUL, 0x7BEA5C6FUL), U64(0xE4820023UL, 0xA2000000UL),  /* 5^44 */
+    U64(0xB35DBF82UL, 0x1AE4F38BUL), U64(0xDDA2802CUL, 0x8A800000UL),  /* 5^45 */
+    U64(0xE0352F62UL, 0xA19E306EUL), U64(0xD50B2037UL, 0xAD200000UL),  /* 5^46 */
+    U64(0x8C213D9DUL, 0xA502DE45UL), U64(0x4526F422UL, 0xCC340000UL),  /* 5^47 */
+    U64(0xAF298D05UL, 0x0E4395D6UL), U64(0x9670B12BUL, 0x7F410000UL),  /* 5^48 */
+    U64(0xDAF3F046UL, 0x51D47B4CUL), U64(0x3C0CDD76UL, 0x5F114000UL),  /* 5^49 */
+    U64(0x88D8762BUL, 0xF324CD0FUL), U64(0xA5880A69UL, 0xFB6AC800UL),  /* 5^50 */
+    U64(0xAB0E93B6UL, 0xEFEE0053UL), U64(0x8EEA0D04UL, 0x7A457A00UL),  /* 5^51 */
+    U64(0xD5D238A4UL, 0xABE98068UL), U64(0x72A49045UL, 0x98D6D880UL),  /* 5^52 */
+    U64(0x85A36366UL, 0xEB71F041UL), U64(0x47A6DA2BUL, 0x7F864750UL),  /* 5^53 */
+    U64(0xA70C3C40UL, 0xA64E6C51UL), U64(0x999090B6UL, 0x5F67D924UL),  /* 5^54 */
+    U64(0xD0CF4B50UL, 0xCFE20765UL), U64(0xFFF4B4E3UL, 0xF741CF6DUL),  /* 5^55 */
+    U64(0x82818F12UL, 0x81ED449FUL), U64(0xBFF8F10EUL, 0x7A8921A4UL),  /* 5^56 */
+    U64(0xA321F2D7UL, 0x226895C7UL), U64(0xAFF72D52UL, 0x192B6A0DUL),  /* 5^57 */
+    U64(0xCBEA6F8CUL, 0xEB02BB39UL), U64(0x9BF4F8A6UL, 0x9F764490UL),  /* 5^58 */
+    U64(0xFEE50B70UL, 0x25C36A08UL), U64(0x02F236D0UL, 0x4753D5B4UL),  /* 5^59 */
+    U64(0x9F4F2726UL, 0x179A2245UL), U64(0x01D76242UL, 0x2C946590UL),  /* 5^60 */
+    U64(0xC722F0EFUL, 0x9D80AAD6UL), U64(0x424D3AD2UL, 0xB7B97EF5UL),  /* 5^61 */
+    U64(0xF8EBAD2BUL, 0x84E0D58BUL), U64(0xD2E08987UL, 0x65A7DEB2UL),  /* 5^62 */
+    U64(0x9B934C3BUL, 0x330C8577UL), U64(0x63CC55F4UL, 0x9F88EB2FUL),  /* 5^63 */
+    U64(0xC2781F49UL, 0xFFCFA6D5UL), U64(0x3CBF6B71UL, 0xC76B25FBUL),  /* 5^64 */
+    U64(0xF316271CUL, 0x7FC3908AUL), U64(0x8BEF464EUL, 0x3945EF7AUL),  /* 5^65 */
+    U64(0x97EDD871UL, 0xCFDA3A56UL), U64(0x97758BF0UL, 0xE3CBB5ACUL),  /* 5^66 */
+    U64(0xBDE94E8EUL, 0x43D0C8ECUL), U64(0x3D52EEEDUL, 0x1CBEA317UL),  /* 5^67 */
+    U64(0xED63A231UL, 0xD4C4FB27UL), U64(0x4CA7AAA8UL, 0x63EE4BDDUL),  /* 5^68 */
+    U64(0x945E455FUL, 0x24FB1CF8UL), U64(0x8FE8CAA9UL, 0x3E74EF6AUL),  /* 5^69 */
+    U64(0xB975D6B6UL, 0xEE39E436UL), U64(0xB3E2FD53UL, 0x8E122B44UL),  /* 5^70 */
+    U64(0xE7D34C64UL, 0xA9C85D44UL), U64(0x60DBBCA8UL, 0x7196B616UL),  /* 5^71 */
+    U64(0x90E40FBEUL, 0xEA1D3A4AUL), U64(0xBC8955E9UL, 0x46FE31CDUL),  /* 5^72 */
+    U64(0xB51D13AEUL, 0xA4A488DDUL), U64(0x6BABAB63UL, 0x98BDBE41UL),  /* 5^73 */
+    U64(0xE264589AUL, 0x4DCDAB14UL), U64(0xC696963CUL, 0x7EED2DD1UL),  /* 5^74 */
+    U64(0x8D7EB760UL, 0x70A08AECUL), U64(0xFC1E1DE5UL, 0xCF543CA2UL),  /* 5^75 */
+    U64(0xB0DE6538UL, 0x8CC8ADA8UL), U64(0x3B25A55FUL, 0x43294BCBUL),  /* 5^76 */
+    U64(0xDD15FE86UL, 0xAFFAD912UL), U64(0x49EF0EB7UL, 0x13F39EBEUL),  /* 5^77 */
+    U64(0x8A2DBF14UL, 0x2DFCC7ABUL), U64(0x6E356932UL, 0x6C784337UL),  /* 5^78 */
+    U64(0xACB92ED9UL, 0x397BF996UL), U64(0x49C2C37FUL, 0x07965404UL),  /* 5^79 */
+    U64(0xD7E77A8FUL, 0x87DAF7FBUL), U64(0xDC33745EUL, 0xC97BE906UL),  /* 5^80 */
+    U64(0x86F0AC99UL, 0xB4E8DAFDUL), U64(0x69A028BBUL, 0x3DED71A3UL),  /* 5^81 */
+    U64(0xA8ACD7C0UL, 0x222311BCUL), U64(0xC40832EAUL, 0x0D68CE0CUL),  /* 5^82 */
+    U64(0xD2D80DB0UL, 0x2AABD62BUL), U64(0xF50A3FA4UL, 0x90C30190UL),  /* 5^83 */
+    U64(0x83C7088EUL, 0x1AAB65DBUL), U64(0x792667C6UL, 0xDA79E0FAUL),  /* 5^84 */
+    U64(0xA4B8CAB1UL, 0xA1563F52UL), U64(0x577001B8UL, 0x91185938UL),  /* 5^85 */
+    U64(0xCDE6FD5EUL, 0x09ABCF26UL), U64(0xED4C0226UL, 0xB55E6F86UL),  /* 5^86 */
+    U64(0x80B05E5AUL, 0xC60B6178UL), U64(0x544F8158UL, 0x315B05B4UL),  /* 5^87 */
+    U64(0xA0DC75F1UL, 0x778E39D6UL), U64(0x696361AEUL, 0x3DB1C721UL),  /* 5^88 */
+    U64(0xC913936DUL, 0xD571C84CUL), U64(0x03BC3A19UL, 0xCD1E38E9UL),  /* 5^89 */
+    U64(0xFB587849UL, 0x4ACE3A5FUL), U64(0x04AB48A0UL, 0x4065C723UL),  /* 5^90 */
+    U64(0x9D174B2DUL, 0xCEC0E47BUL), U64(0x62EB0D64UL, 0x283F9C76UL),  /* 5^91 */
+    U64(0xC45D1DF9UL, 0x42711D9AUL), U64(0x3BA5D0BDUL, 0x324F8394UL),  /* 5^92 */
+    U64(0xF5746577UL, 0x930D6500UL), U64(0xCA8F44ECUL, 0x7EE36479UL),  /* 5^93 */
+    U64(0x9968BF6AUL, 0xBBE85F20UL), U64(0x7E998B13UL, 0xCF4E1ECBUL),  /* 5^94 */
+    U64(0xBFC2EF45UL, 0x6AE276E8UL), U64(0x9E3FEDD8UL, 0xC321A67EUL),  /* 5^95 */
+    U64(0xEFB3AB16UL, 0xC59B14A2UL), U64(0xC5CFE94EUL, 0xF3EA101EUL),  /* 5^96 */
+    U64(0x95D04AEEUL, 0x3B80ECE5UL), U64(0xBBA1F1D1UL, 0x58724A12UL),  /* 5^97 */
+    U64(0xBB445DA9UL, 0xCA61281FUL), U64(0x2A8A6E45UL, 0xAE8EDC97UL),  /* 5^98 */
+    U64(0xEA157514UL, 0x3CF97226UL), U64(0xF52D09D7UL, 0x1A3293BDUL),  /* 5^99 */
+    U64(0x924D692CUL, 0xA61BE758UL), U64(0x593C2626UL, 0x705F9C56UL),  /* 5^100 */
+    U64(0xB6E0C377UL, 0xCFA2E12EUL), U64(0x6F8B2FB0UL, 0x0C77836CUL),  /* 5^101 */
+    U64(0xE498F455UL, 0xC38B997AUL), U64(0x0B6DFB9CUL, 0x0F956447UL),  /* 5^102 */
+    U64(0x8EDF98B5UL, 0x9A373FECUL), U64(0x4724BD41UL, 0x89BD5EACUL),  /* 5^103 */
+    U64(0xB2977EE3UL, 0x00C50FE7UL), U64(0x58EDEC91UL, 0xEC2CB657UL),  /* 5^104 */
+    U64(0xDF3D5E9BUL, 0xC0F653E1UL), U64(0x2F2967B6UL, 0x6737E3EDUL),  /* 5^105 */
+    U64(0x8B865B21UL, 0x5899F46CUL), U64(0xBD79E0D2UL, 0x0082EE74UL),  /* 5^106 */
+    U64(0xAE67F1E9UL, 0xAEC07187UL), U64(0xECD85906UL, 0x80A3AA11UL),  /* 5^107 */
+    U64(0xDA01EE64UL, 0x1A708DE9UL), U64(0xE80E6F48UL, 0x20CC9495UL),  /* 5^108 */
+    U64(0x884134FEUL, 0x908658B2UL), U64(0x3109058DUL, 0x147FDCDDUL),  /* 5^109 */
+    U64(0xAA51823EUL, 0x34A7EEDEUL), U64(0xBD4B46F0UL, 0x599FD415UL),  /* 5^110 */
+    U64(0xD4E5E2CDUL, 0xC1D1EA96UL), U64(0x6C9E18ACUL, 0x7007C91AUL),  /* 5^111 */
+    U64(0x850FADC0UL, 0x9923329EUL), U64(0x03E2CF6BUL, 0xC604DDB0UL),  /* 5^112 */
+    U64(0xA6539930UL, 0xBF6BFF45UL), U64(0x84DB8346UL, 0xB786151CUL),  /* 5^113 */
+    U64(0xCFE87F7CUL, 0xEF46FF16UL), U64(0xE6126418UL, 0x65679A63UL),  /* 5^114 */
+    U64(0x81F14FAEUL, 0x158C5F6EUL), U64(0x4FCB7E8FUL, 0x3F60C07EUL),  /* 5^115 */
+    U64(0xA26DA399UL, 0x9AEF7749UL), U64(0xE3BE5E33UL, 0x0F38F09DUL),  /* 5^116 */
+    U64(0xCB090C80UL, 0x01AB551CUL), U64(0x5CADF5BFUL, 0xD3072CC5UL),  /* 5^117 */
+    U64(0xFDCB4FA0UL, 0x02162A63UL), U64(0x73D9732FUL, 0xC7C8F7F6UL),  /* 5^118 */
+    U64(0x9E9F11C4UL, 0x014DDA7EUL), U64(0x2867E7FDUL, 0xDCDD9AFAUL),  /* 5^119 */
+    U64(0xC646D635UL, 0x01A1511DUL), U64(0xB281E1FDUL, 0x541501B8UL),  /* 5^120 */
+    U64(0xF7D88BC2UL, 0x4209A565UL), U64(0x1F225A7CUL, 0xA91A4226UL),  /* 5^121 */
+    U64(0x9AE75759UL, 0x6946075FUL), U64(0x3375788DUL, 0xE9B06958UL),  /* 5^122 */
+    U64(0xC1A12D2FUL, 0xC3978937UL), U64(0x0052D6B1UL, 0x641C83AEUL),  /* 5^123 */
+    U64(0xF209787BUL, 0xB47D6B84UL), U64(0xC0678C5DUL, 0xBD23A49AUL),  /* 5^124 */
+    U64(0x9745EB4DUL, 0x50CE6332UL), U64(0xF840B7BAUL, 0x963646E0UL),  /* 5^125 */
+    U64(0xBD176620UL, 0xA501FBFFUL), U64(0xB650E5A9UL, 0x3BC3D898UL),  /* 5^126 */
+    U64(0xEC5D3FA8UL, 0xCE427AFFUL), U64(0xA3E51F13UL, 0x8AB4CEBEUL),  /* 5^127 */
+    U64(0x93BA47C9UL, 0x80E98CDFUL), U64(0xC66F336CUL, 0x36B10137UL),  /* 5^128 */
+    U64(0xB8A8D9BBUL, 0xE123F017UL), U64(0xB80B0047UL, 0x445D4184UL),  /* 5^129 */
+    U64(0xE6D3102AUL, 0xD96CEC1DUL), U64(0xA60DC059UL, 0x157491E5UL),  /* 5^130 */
+    U64(0x9043EA1AUL, 0xC7E41392UL), U64(0x87C89837UL, 0xAD68DB2FUL),  /* 5^131 */
+    U64(0xB454E4A1UL, 0x79DD1877UL), U64(0x29BABE45UL, 0x98C311FBUL),  /* 5^132 */
+    U64(0xE16A1DC9UL, 0xD8545E94UL), U64(0xF4296DD6UL, 0xFEF3D67AUL),  /* 5^133 */
+    U64(0x8CE2529EUL, 0x2734BB1DUL), U64(0x1899E4A6UL, 0x5F58660CUL),  /* 5^134 */
+    U64(0xB01AE745UL, 0xB101E9E4UL), U64(0x5EC05DCFUL, 0xF72E7F8FUL),  /* 5^135 */
+    U64(0xDC21A117UL, 0x1D42645DUL), U64(0x76707543UL, 0xF4FA1F73UL),  /* 5^136 */
+    U64(0x899504AEUL, 0x72497EBAUL), U64(0x6A06494AUL, 0x791C53A8UL),  /* 5^137 */
+    U64(0xABFA45DAUL, 0x0EDBDE69UL), U64(0x0487DB9DUL, 0x17636892UL),  /* 5^138 */
+    U64(0xD6F8D750UL, 0x9292D603UL), U64(0x45A9D284UL, 0x5D3C42B6UL),  /* 5^139 */
+    U64(0x865B8692UL, 0x5B9BC5C2UL), U64(0x0B8A2392UL, 0xBA45A9B2UL),  /* 5^140 */
+    U64(0xA7F26836UL, 0xF282B732UL), U64(0x8E6CAC77UL, 0x68D7141EUL),  /* 5^141 */
+    U64(0xD1EF0244UL, 0xAF2364FFUL), U64(0x3207D795UL, 0x430CD926UL),  /* 5^142 */
+    U64(0x8335616AUL, 0xED761F1FUL), U64(0x7F44E6BDUL, 0x49E807B8UL),  /* 5^143 */
+    U64(0xA402B9C5UL, 0xA8D3A6E7UL), U64(0x5F16206CUL, 0x9C6209A6UL),  /* 5^144 */
+    U64(0xCD036837UL, 0x130890A1UL), U64(0x36DBA887UL, 0xC37A8C0FUL),  /* 5^145 */
+    U64(0x80222122UL, 0x6BE55A64UL), U64(0xC2494954UL, 0xDA2C9789UL),  /* 5^146 */
+    U64(0xA02AA96BUL, 0x06DEB0FDUL), U64(0xF2DB9BAAUL, 0x10B7BD6CUL),  /* 5^147 */
+    U64(0xC83553C5UL, 0xC8965D3DUL), U64(0x6F928294UL, 0x94E5ACC7UL),  /* 5^148 */
+    U64(0xFA42A8B7UL, 0x3ABBF48CUL), U64(0xCB772339UL, 0xBA1F17F9UL),  /* 5^149 */
+    U64(0x9C69A972UL, 0x84B578D7UL), U64(0xFF2A7604UL, 0x14536EFBUL),  /* 5^150 */
+    U64(0xC38413CFUL, 0x25E2D70DUL), U64(0xFEF51385UL, 0x19684ABAUL),  /* 5^151 */
+    U64(0xF46518C2UL, 0xEF5B8CD1UL), U64(0x7EB25866UL, 0x5FC25D69UL),  /* 5^152 */
+    U64(0x98BF2F79UL, 0xD5993802UL), U64(0xEF2F773FUL, 0xFBD97A61UL),  /* 5^153 */
+    U64(0xBEEEFB58UL, 0x4AFF8603UL), U64(0xAAFB550FUL, 0xFACFD8FAUL),  /* 5^154 */
+    U64(0xEEAABA2EUL, 0x5DBF6784UL), U64(0x95BA2A53UL, 0xF983CF38UL),  /* 5^155 */
+    U64(0x952AB45CUL, 0xFA97A0B2UL), U64(0xDD945A74UL, 0x7BF26183UL),  /* 5^156 */
+    U64(0xBA756174UL, 0x393D88DFUL), U64(0x94F97111UL, 0x9AEEF9E4UL),  /* 5^157 */
+    U64(0xE912B9D1UL, 0x478CEB17UL), U64(0x7A37CD56UL, 0x01AAB85DUL),  /* 5^158 */
+    U64(0x91ABB422UL, 0xCCB812EEUL), U64(0xAC62E055UL, 0xC10AB33AUL),  /* 5^159 */
+    U64(0xB616A12BUL, 0x7FE617AAUL), U64(0x577B986BUL, 0x314D6009UL),  /* 5^160 */
+    U64(0xE39C4976UL, 0x5FDF9D94UL), U64(0xED5A7E85UL, 0xFDA0B80BUL),  /* 5^161 */
+    U64(0x8E41ADE9UL, 0xFBEBC27DUL), U64(0x14588F13UL, 0xBE847307UL),  /* 5^162 */
+    U64(0xB1D21964UL, 0x7AE6B31CUL), U64(0x596EB2D8UL, 0xAE258FC8UL),  /* 5^163 */
+    U64(0xDE469FBDUL, 0x99A05FE3UL), U64(0x6FCA5F8EUL, 0xD9AEF3BBUL),  /* 5^164 */
+    U64(0x8AEC23D6UL, 0x80043BEEUL), U64(0x25DE7BB9UL, 0x480D5854UL),  /* 5^165 */
+    U64(0xADA72CCCUL, 0x20054AE9UL), U64(0xAF561AA7UL, 0x9A10AE6AUL),  /* 5^166 */
+    U64(0xD910F7FFUL, 0x28069DA4UL), U64(0x1B2BA151UL, 0x8094DA04UL),  /* 5^167 */
+    U64(0x87AA9AFFUL, 0x79042286UL), U64(0x90FB44D2UL, 0xF05D0842UL),  /* 5^168 */
+    U64(0xA99541BFUL, 0x57452B28UL), U64(0x353A1607UL, 0xAC744A53UL),  /* 5^169 */
+    U64(0xD3FA922FUL, 0x2D1675F2UL), U64(0x42889B89UL, 0x97915CE8UL),  /* 5^170 */
+    U64(0x847C9B5DUL, 0x7C2E09B7UL), U64(0x69956135UL, 0xFEBADA11UL),  /* 5^171 */
+    U64(0xA59BC234UL, 0xDB398C25UL), U64(0x43FAB983UL, 0x7E699095UL),  /* 5^172 */
+    U64(0xCF02B2C2UL, 0x1207EF2EUL), U64(0x94F967E4UL, 0x5E03F4BBUL),  /* 5^173 */
+    U64(0x8161AFB9UL, 0x4B44F57DUL), U64(0x1D1BE0EEUL, 0xBAC278F5UL),  /* 5^174 */
+    U64(0xA1BA1BA7UL, 0x9E1632DCUL), U64(0x6462D92AUL, 0x69731732UL),  /* 5^175 */
+    U64(0xCA28A291UL, 0x859BBF93UL), U64(0x7D7B8F75UL, 0x03CFDCFEUL),  /* 5^176 */
+    U64(0xFCB2CB35UL, 0xE702AF78UL), U64(0x5CDA7352UL, 0x44C3D43EUL),  /* 5^177 */
+    U64(0x9DEFBF01UL, 0xB061ADABUL), U64(0x3A088813UL, 0x6AFA64A7UL),  /* 5^178 */
+    U64(0xC56BAEC2UL, 0x1C7A1916UL), U64(0x088AAA18UL, 0x45B8FDD0UL),  /* 5^179 */
+    U64(0xF6C69A72UL, 0xA3989F5BUL), U64(0x8AAD549EUL, 0x57273D45UL),  /* 5^180 */
+    U64(0x9A3C2087UL, 0xA63F6399UL), U64(0x36AC54E2UL, 0xF678864BUL),  /* 5^181 */
+    U64(0xC0CB28A9UL, 0x8FCF3C7FUL), U64(0x84576A1BUL, 0xB416A7DDUL),  /* 5^182 */
+    U64(0xF0FDF2D3UL, 0xF3C30B9FUL), U64(0x656D44A2UL, 0xA11C51D5UL),  /* 5^183 */
+    U64(0x969EB7C4UL, 0x7859E743UL), U64(0x9F644AE5UL, 0xA4B1B325UL),  /* 5^184 */
+    U64(0xBC4665B5UL, 0x96706114UL), U64(0x873D5D9FUL, 0x0DDE1FEEUL),  /* 5^185 */
+    U64(0xEB57FF22UL, 0xFC0C7959UL), U64(0xA90CB506UL, 0xD155A7EAUL),  /* 5^186 */
+    U64(0x9316FF75UL, 0xDD87CBD8UL), U64(0x09A7F124UL, 0x42D588F2UL),  /* 5^187 */
+    U64(0xB7DCBF53UL, 0x54E9BECEUL), U64(0x0C11ED6DUL, 0x538AEB2FUL),  /* 5^188 */
+    U64(0xE5D3EF28UL, 0x2A242E81UL), U64(0x8F1668C8UL, 0xA86DA5FAUL),  /* 5^189 */
+    U64(0x8FA47579UL, 0x1A569D10UL), U64(0xF96E017DUL, 0x694487BCUL),  /* 5^190 */
+    U64(0xB38D92D7UL, 0x60EC4455UL), U64(0x37C981DCUL, 0xC395A9ACUL),  /* 5^191 */
+    U64(0xE070F78DUL, 0x3927556AUL), U64(0x85BBE253UL, 0xF47B1417UL),  /* 5^192 */
+    U64(0x8C469AB8UL, 0x43B89562UL), U64(0x93956D74UL, 0x78CCEC8EUL),  /* 5^193 */
+    U64(0xAF584166UL, 0x54A6BABBUL), U64(0x387AC8D1UL, 0x970027B2UL),  /* 5^194 */
+    U64(0xDB2E51BFUL, 0xE9D0696AUL), U64(0x06997B05UL, 0xFCC0319EUL),  /* 5^195 */
+    U64(0x88FCF317UL, 0xF22241E2UL), U64(0x441FECE3UL, 0xBDF81F03UL),  /* 5^196 */
+    U64(0xAB3C2FDDUL, 0xEEAAD25AUL), U64(0xD527E81CUL, 0xAD7626C3UL),  /* 5^197 */
+    U64(0xD60B3BD5UL, 0x6A5586F1UL), U64(0x8A71E223UL, 0xD8D3B074UL),  /* 5^198 */
+    U64(0x85C70565UL, 0x62757456UL), U64(0xF6872D56UL, 0x67844E49UL),  /* 5^199 */
+    U64(0xA738C6BEUL, 0xBB12D16CUL), U64(0xB428F8ACUL, 0x016561DBUL),  /* 5^200 */
+    U64(0xD106F86EUL, 0x69D785C7UL), U64(0xE13336D7UL, 0x01BEBA52UL),  /* 5^201 */
+    U64(0x82A45B45UL, 0x0226B39CUL), U64(0xECC00246UL, 0x61173473UL),  /* 5^202 */
+    U64(0xA34D7216UL, 0x42B06084UL), U64(0x27F002D7UL, 0xF95D0190UL),  /* 5^203 */
+    U64(0xCC20CE9BUL, 0xD35C78A5UL), U64(0x31EC038DUL, 0xF7B441F4UL),  /* 5^204 */
+    U64(0xFF290242UL, 0xC83396CEUL), U64(0x7E670471UL, 0x75A15271UL),  /* 5^205 */
+    U64(0x9F79A169UL, 0xBD203E41UL), U64(0x0F0062C6UL, 0xE984D386UL),  /* 5^206 */
+    U64(0xC75809C4UL, 0x2C684DD1UL), U64(0x52C07B78UL, 0xA3E60868UL),  /* 5^207 */
+    U64(0xF92E0C35UL, 0x37826145UL), U64(0xA7709A56UL, 0xCCDF8A82UL),  /* 5^208 */
+    U64(0x9BBCC7A1UL, 0x42B17CCBUL), U64(0x88A66076UL, 0x400BB691UL),  /* 5^209 */
+    U64(0xC2ABF989UL, 0x935DDBFEUL), U64(0x6ACFF893UL, 0xD00EA435UL),  /* 5^210 */
+    U64(0xF356F7EBUL, 0xF83552FEUL), U64(0x0583F6B8UL, 0xC4124D43UL),  /* 5^211 */
+    U64(0x98165AF3UL, 0x7B2153DEUL), U64(0xC3727A33UL, 0x7A8B704AUL),  /* 5^212 */
+    U64(0xBE1BF1B0UL, 0x59E9A8D6UL), U64(0x744F18C0UL, 0x592E4C5CUL),  /* 5^213 */
+    U64(0xEDA2EE1CUL, 0x7064130CUL), U64(0x1162DEF0UL, 0x6F79DF73UL),  /* 5^214 */
+    U64(0x9485D4D1UL, 0xC63E8BE7UL), U64(0x8ADDCB56UL, 0x45AC2BA8UL),  /* 5^215 */
+    U64(0xB9A74A06UL, 0x37CE2EE1UL), U64(0x6D953E2BUL, 0xD7173692UL),  /* 5^216 */
+    U64(0xE8111C87UL, 0xC5C1BA99UL), U64(0xC8FA8DB6UL, 0xCCDD0437UL),  /* 5^217 */
+    U64(0x910AB1D4UL, 0xDB9914A0UL), U64(0x1D9C9892UL, 0x400A22A2UL),  /* 5^218 */
+    U64(0xB54D5E4AUL, 0x127F59C8UL), U64(0x2503BEB6UL, 0xD00CAB4BUL),  /* 5^219 */
+    U64(0xE2A0B5DCUL, 0x971F303AUL), U64(0x2E44AE64UL, 0x840FD61DUL),  /* 5^220 */
+    U64(0x8DA471A9UL, 0xDE737E24UL), U64(0x5CEAECFEUL, 0xD289E5D2UL),  /* 5^221 */
+    U64(0xB10D8E14UL, 0x56105DADUL), U64(0x7425A83EUL, 0x872C5F47UL),  /* 5^222 */
+    U64(0xDD50F199UL, 0x6B947518UL), U64(0xD12F124EUL, 0x28F77719UL),  /* 5^223 */
+    U64(0x8A5296FFUL, 0xE33CC92FUL), U64(0x82BD6B70UL, 0xD99AAA6FUL),  /* 5^224 */
+    U64(0xACE73CBFUL, 0xDC0BFB7BUL), U64(0x636CC64DUL, 0x1001550BUL),  /* 5^225 */
+    U64(0xD8210BEFUL, 0xD30EFA5AUL), U64(0x3C47F7E0UL, 0x5401AA4EUL),  /* 5^226 */
+    U64(0x8714A775UL, 0xE3E95C78UL), U64(0x65ACFAECUL, 0x34810A71UL),  /* 5^227 */
+    U64(0xA8D9D153UL, 0x5CE3B396UL), U64(0x7F1839A7UL, 0x41A14D0DUL),  /* 5^228 */
+    U64(0xD31045A8UL, 0x341CA07CUL), U64(0x1EDE4811UL, 0x1209A050UL),  /* 5^229 */
+    U64(0x83EA2B89UL, 0x2091E44DUL), U64(0x934AED0AUL, 0xAB460432UL),  /* 5^230 */
+    U64(0xA4E4B66BUL, 0x68B65D60UL), U64(0xF81DA84DUL, 0x5617853FUL),  /* 5^231 */
+    U64(0xCE1DE406UL, 0x42E3F4B9UL), U64(0x36251260UL, 0xAB9D668EUL),  /* 5^232 */
+    U64(0x80D2AE83UL, 0xE9CE78F3UL), U64(0xC1D72B7CUL, 0x6B426019UL),  /* 5^233 */
+    U64(0xA1075A24UL, 0xE4421730UL), U64(0xB24CF65BUL, 0x8612F81FUL),  /* 5^234 */
+    U64(0xC94930AEUL, 0x1D529CFCUL), U64(0xDEE033F2UL, 0x6797B627UL),  /* 5^235 */
+    U64(0xFB9B7CD9UL, 0xA4A7443CUL), U64(0x169840EFUL, 0x017DA3B1UL),  /* 5^236 */
+    U64(0x9D412E08UL, 0x06E88AA5UL), U64(0x8E1F2895UL, 0x60EE864EUL),  /* 5^237 */
+    U64(0xC491798AUL, 0x08A2AD4EUL), U64(0xF1A6F2BAUL, 0xB92A27E2UL),  /* 5^238 */
+    U64(0xF5B5D7ECUL, 0x8ACB58A2UL), U64(0xAE10AF69UL, 0x6774B1DBUL),  /* 5^239 */
+    U64(0x9991A6F3UL, 0xD6BF1765UL), U64(0xACCA6DA1UL, 0xE0A8EF29UL),  /* 5^240 */
+    U64(0xBFF610B0UL, 0xCC6EDD3FUL), U64(0x17FD090AUL, 0x58D32AF3UL),  /* 5^241 */
+    U64(0xEFF394DCUL, 0xFF8A948EUL), U64(0xDDFC4B4CUL, 0xEF07F5B0UL),  /* 5^242 */
+    U64(0x95F83D0AUL, 0x1FB69CD9UL), U64(0x4ABDAF10UL, 0x1564F98EUL),  /* 5^243 */
+    U64(0xBB764C4CUL, 0xA7A4440FUL), U64(0x9D6D1AD4UL, 0x1ABE37F1UL),  /* 5^244 */
+    U64(0xEA53DF5FUL, 0xD18D5513UL), U64(0x84C86189UL, 0x216DC5EDUL),  /* 5^245 */
+    U64(0x92746B9BUL, 0xE2F8552CUL), U64(0x32FD3CF5UL, 0xB4E49BB4UL),  /* 5^246 */
+    U64(0xB7118682UL, 0xDBB66A77UL), U64(0x3FBC8C33UL, 0x221DC2A1UL),  /* 5^247 */
+    U64(0xE4D5E823UL, 0x92A40515UL), U64(0x0FABAF3FUL, 0xEAA5334AUL),  /* 5^248 */
+    U64(0x8F05B116UL, 0x3BA6832DUL), U64(0x29CB4D87UL, 0xF2A7400EUL),  /* 5^249 */
+    U64(0xB2C71D5BUL, 0xCA9023F8UL), U64(0x743E20E9UL, 0xEF511012UL),  /* 5^250 */
+    U64(0xDF78E4B2UL, 0xBD342CF6UL), U64(0x914DA924UL, 0x6B255416UL),  /* 5^251 */
+    U64(0x8BAB8EEFUL, 0xB6409C1AUL), U64(0x1AD089B6UL, 0xC2F7548EUL),  /* 5^252 */
+    U64(0xAE9672ABUL, 0xA3D0C320UL), U64(0xA184AC24UL, 0x73B529B1UL),  /* 5^253 */
+    U64(0xDA3C0F56UL, 0x8CC4F3E8UL), U64(0xC9E5D72DUL, 0x90A2741EUL),  /* 5^254 */
+    U64(0x88658996UL, 0x17FB1871UL), U64(0x7E2FA67CUL, 0x7A658892UL),  /* 5^255 */
+    U64(0xAA7EEBFBUL, 0x9DF9DE8DUL), U64(0xDDBB901BUL, 0x98FEEAB7UL),  /* 5^256 */
+    U64(0xD51EA6FAUL, 0x85785631UL), U64(0x552A7422UL, 0x7F3EA565UL),  /* 5^257 */
+    U64(0x8533285CUL, 0x936B35DEUL), U64(0xD53A8895UL, 0x8F87275FUL),  /* 5^258 */
+    U64(0xA67FF273UL, 0xB8460356UL), U64(0x8A892ABAUL, 0xF368F137UL),  /* 5^259 */
+    U64(0xD01FEF10UL, 0xA657842CUL), U64(0x2D2B7569UL, 0xB0432D85UL),  /* 5^260 */
+    U64(0x8213F56AUL, 0x67F6B29BUL), U64(0x9C3B2962UL, 0x0E29FC73UL),  /* 5^261 */
+    U64(0xA298F2C5UL, 0x01F45F42UL), U64(0x8349F3BAUL, 0x91B47B8FUL),  /* 5^262 */
+    U64(0xCB3F2F76UL, 0x42717713UL), U64(0x241C70A9UL, 0x36219A73UL),  /* 5^263 */
+    U64(0xFE0EFB53UL, 0xD30DD4D7UL), U64(0xED238CD3UL, 0x83AA0110UL),  /* 5^264 */
+    U64(0x9EC95D14UL, 0x63E8A506UL), U64(0xF4363804UL, 0x324A40AAUL),  /* 5^265 */
+    U64(0xC67BB459UL, 0x7CE2CE48UL), U64(0xB143C605UL, 0x3EDCD0D5UL),  /* 5^266 */
+    U64(0xF81AA16FUL, 0xDC1B81DAUL), U64(0xDD94B786UL, 0x8E94050AUL),  /* 5^267 */
+    U64(0x9B10A4E5UL, 0xE9913128UL), U64(0xCA7CF2B4UL, 0x191C8326UL),  /* 5^268 */
+    U64(0xC1D4CE1FUL, 0x63F57D72UL), U64(0xFD1C2F61UL, 0x1F63A3F0UL),  /* 5^269 */
+    U64(0xF24A01A7UL, 0x3CF2DCCFUL), U64(0xBC633B39UL, 0x673C8CECUL),  /* 5^270 */
+    U64(0x976E4108UL, 0x8617CA01UL), U64(0xD5BE0503UL, 0xE085D813UL),  /* 5^271 */
+    U64(0xBD49D14AUL, 0xA79DBC82UL), U64(0x4B2D8644UL, 0xD8A74E18UL),  /* 5^272 */
+    U64(0xEC9C459DUL, 0x51852BA2UL), U64(0xDDF8E7D6UL, 0x0ED1219EUL),  /* 5^273 */
+    U64(0x93E1AB82UL, 0x52F33B45UL), U64(0xCABB90E5UL, 0xC942B503UL),  /* 5^274 */
+    U64(0xB8DA1662UL, 0xE7B00A17UL), U64(0x3D6A751FUL, 0x3B936243UL),  /* 5^275 */
+    U64(0xE7109BFBUL, 0xA19C0C9DUL), U64(0x0CC51267UL, 0x0A783AD4UL),  /* 5^276 */
+    U64(0x906A617DUL, 0x450187E2UL), U64(0x27FB2B80UL, 0x668B24C5UL),  /* 5^277 */
+    U64(0xB484F9DCUL, 0x9641E9DAUL), U64(0xB1F9F660UL, 0x802DEDF6UL),  /* 5^278 */
+    U64(0xE1A63853UL, 0xBBD26451UL), U64(0x5E7873F8UL, 0xA0396973UL),  /* 5^279 */
+    U64(0x8D07E334UL, 0x55637EB2UL), U64(0xDB0B487BUL, 0x6423E1E8UL),  /* 5^280 */
+    U64(0xB049DC01UL, 0x6ABC5E5FUL), U64(0x91CE1A9AUL, 0x3D2CDA62UL),  /* 5^281 */
+    U64(0xDC5C5301UL, 0xC56B75F7UL), U64(0x7641A140UL, 0xCC7810FBUL),  /* 5^282 */
+    U64(0x89B9B3E1UL, 0x1B6329BAUL), U64(0xA9E904C8UL, 0x7FCB0A9DUL),  /* 5^283 */
+    U64(0xAC2820D9UL, 0x623BF429UL), U64(0x546345FAUL, 0x9FBDCD44UL),  /* 5^284 */
+    U64(0xD732290FUL, 0xBACAF133UL), U64(0xA97C1779UL, 0x47AD4095UL),  /* 5^285 */
+    U64(0x867F59A9UL, 0xD4BED6C0UL), U64(0x49ED8EABUL, 0xCCCC485DUL),  /* 5^286 */
+    U64(0xA81F3014UL, 0x49EE8C70UL), U64(0x5C68F256UL, 0xBFFF5A74UL),  /* 5^287 */
+    U64(0xD226FC19UL, 0x5C6A2F8CUL), U64(0x73832EECUL, 0x6FFF3111UL),  /* 5^288 */
+    U64(0x83585D8FUL, 0xD9C25DB7UL), U64(0xC831FD53UL, 0xC5FF7EABUL),  /* 5^289 */
+    U64(0xA42E74F3UL, 0xD032F525UL), U64(0xBA3E7CA8UL, 0xB77F5E55UL),  /* 5^290 */
+    U64(0xCD3A1230UL, 0xC43FB26FUL), U64(0x28CE1BD2UL, 0xE55F35EBUL),  /* 5^291 */
+    U64(0x80444B5EUL, 0x7AA7CF85UL), U64(0x7980D163UL, 0xCF5B81B3UL),  /* 5^292 */
+    U64(0xA0555E36UL, 0x1951C366UL), U64(0xD7E105BCUL, 0xC332621FUL),  /* 5^293 */
+    U64(0xC86AB5C3UL, 0x9FA63440UL), U64(0x8DD9472BUL, 0xF3FEFAA7UL),  /* 5^294 */
+    U64(0xFA856334UL, 0x878FC150UL), U64(0xB14F98F6UL, 0xF0FEB951UL),  /* 5^295 */
+    U64(0x9C935E00UL, 0xD4B9D8D2UL), U64(0x6ED1BF9AUL, 0x569F33D3UL),  /* 5^296 */
+    U64(0xC3B83581UL, 0x09E84F07UL), U64(0x0A862F80UL, 0xEC4700C8UL),  /* 5^297 */
+    U64(0xF4A642E1UL, 0x4C6262C8UL), U64(0xCD27BB61UL, 0x2758C0FAUL),  /* 5^298 */
+    U64(0x98E7E9CCUL, 0xCFBD7DBDUL), U64(0x8038D51CUL, 0xB897789CUL),  /* 5^299 */
+    U64(0xBF21E440UL, 0x03ACDD2CUL), U64(0xE0470A63UL, 0xE6BD56C3UL),  /* 5^300 */
+    U64(0xEEEA5D50UL, 0x04981478UL), U64(0x1858CCFCUL, 0xE06CAC74UL),  /* 5^301 */
+    U64(0x95527A52UL, 0x02DF0CCBUL), U64(0x0F37801EUL, 0x0C43EBC8UL),  /* 5^302 */
+    U64(0xBAA718E6UL, 0x8396CFFDUL), U64(0xD3056025UL, 0x8F54E6BAUL),  /* 5^303 */
+    U64(0xE950DF20UL, 0x247C83FDUL), U64(0x47C6B82EUL, 0xF32A2069UL),  /* 5^304 */
+    U64(0x91D28B74UL, 0x16CDD27EUL), U64(0x4CDC331DUL, 0x57FA5441UL),  /* 5^305 */
+    U64(0xB6472E51UL, 0x1C81471DUL), U64(0xE0133FE4UL, 0xADF8E952UL),  /* 5^306 */
+    U64(0xE3D8F9E5UL, 0x63A198E5UL), U64(0x58180FDDUL, 0xD97723A6UL),  /* 5^307 */
+    U64(0x8E679C2FUL, 0x5E44FF8FUL), U64(0x570F09EAUL, 0xA7EA7648UL)   /* 5^308 */
+};
+/*  powers of 10 from 10^-348 to 10^340 in steps of 8, as normalized 64-bit
+ *  significand and binary exponent (rounded), for the Grisu algorithm
+ */
+static const struct json_diyfp pow10_cached[] = {
+    { U64(0xFA8FD5A0UL, 0x081C0288UL), -1220 },  /* 10^-348 */
+    { U64(0xBAAEE17FUL, 0xA23EBF76UL), -1193 },  /* 10^-340 */
+    { U64(0x8B16FB20UL, 0x3055AC76UL), -1166 },  /* 10^-332 */
+    { U64(0xCF42894AUL, 0x5DCE35EAUL), -1140 },  /* 10^-324 */
+    { U64(0x9A6BB0AAUL, 0x55653B2DUL), -1113 },  /* 10^-316 */
+    { U64(0xE61ACF03UL, 0x3D1A45DFUL), -1087 },  /* 10^-308 */
+    { U64(0xAB70FE17UL, 0xC79AC6CAUL), -1060 },  /* 10^-300 */
+    { U64(0xFF77B1FCUL, 0xBEBCDC4FUL), -1034 },  /* 10^-292 */
+    { U64(0xBE5691EFUL, 0x416BD60CUL), -1007 },  /* 10^-284 */
+    { U64(0x8DD01FADUL, 0x907FFC3CUL), -980 },  /* 10^-276 */
+    { U64(0xD3515C28UL, 0x31559A83UL), -954 },  /* 10^-268 */
+    { U64(0x9D71AC8FUL, 0xADA6C9B5UL), -927 },  /* 10^-260 */
+    { U64(0xEA9C2277UL, 0x23EE8BCBUL), -901 },  /* 10^-252 */
+    { U64(0xAECC4991UL, 0x4078536DUL), -874 },  /* 10^-244 */
+    { U64(0x823C1279UL, 0x5DB6CE57UL), -847 },  /* 10^-236 */
+    { U64(0xC2109436UL, 0x4DFB5637UL), -821 },  /* 10^-228 */
+    { U64(0x9096EA6FUL, 0x3848984FUL), -794 },  /* 10^-220 */
+    { U64(0xD77485CBUL, 0x25823AC7UL), -768 },  /* 10^-212 */
+    { U64(0xA086CFCDUL, 0x97BF97F4UL), -741 },  /* 10^-204 */
+    { U64(0xEF340A98UL, 0x172AACE5UL), -715 },  /* 10^-196 */
+    { U64(0xB23867FBUL, 0x2A35B28EUL), -688 },  /* 10^-188 */
+    { U64(0x84C8D4DFUL, 0xD2C63F3BUL), -661 },  /* 10^-180 */
+    { U64(0xC5DD4427UL, 0x1AD3CDBAUL), -635 },  /* 10^-172 */
+    { U64(0x936B9FCEUL, 0xBB25C996UL), -608 },  /* 10^-164 */
+    { U64(0xDBAC6C24UL, 0x7D62A584UL), -582 },  /* 10^-156 */
+    { U64(0xA3AB6658UL, 0x0D5FDAF6UL), -555 },  /* 10^-148 */
+    { U64(0xF3E2F893UL, 0xDEC3F126UL), -529 },  /* 10^-140 */
+    { U64(0xB5B5ADA8UL, 0xAAFF80B8UL), -502 },  /* 10^-132 */
+    { U64(0x87625F05UL, 0x6C7C4A8BUL), -475 },  /* 10^-124 */
+    { U64(0xC9BCFF60UL, 0x34C13053UL), -449 },  /* 10^-116 */
+    { U64(0x964E858CUL, 0x91BA2655UL), -422 },  /* 10^-108 */
+    { U64(0xDFF97724UL, 0x70297EBDUL), -396 },  /* 10^-100 */
+    { U64(0xA6DFBD9FUL, 0xB8E5B88FUL), -369 },  /* 10^-92 */
+    { U64(0xF8A95FCFUL, 0x88747D94UL), -343 },  /* 10^-84 */
+    { U64(0xB9447093UL, 0x8FA89BCFUL), -316 },  /* 10^-76 */
+    { U64(0x8A08F0F8UL, 0xBF0F156BUL), -289 },  /* 10^-68 */
+    { U64(0xCDB02555UL, 0x653131B6UL), -263 },  /* 10^-60 */
+    { U64(0x993FE2C6UL, 0xD07B7FACUL), -236 },  /* 10^-52 */
+    { U64(0xE45C10C4UL, 0x2A2B3B06UL), -210 },  /* 10^-44 */
+    { U64(0xAA242499UL, 0x697392D3UL), -183 },  /* 10^-36 */
+    { U64(0xFD87B5F2UL, 0x8300CA0EUL), -157 },  /* 10^-28 */
+    { U64(0xBCE50864UL, 0x92111AEBUL), -130 },  /* 10^-20 */
+    { U64(0x8CBCCC09UL, 0x6F5088CCUL), -103 },  /* 10^-12 */
+    { U64(0xD1B71758UL, 0xE219652CUL), -77 },  /* 10^-4 */
+    { U64(0x9C400000UL, 0x00000000UL), -50 },  /* 10^4 */
+    { U64(0xE8D4A510UL, 0x00000000UL), -24 },  /* 10^12 */
+    { U64(0xAD78EBC5UL, 0xAC620000UL), 3 },  /* 10^20 */
+    { U64(0x813F3978UL, 0xF8940984UL), 30 },  /* 10^28 */
+    { U64(0xC097CE7BUL, 0xC90715B3UL), 56 },  /* 10^36 */
+    { U64(0x8F7E32CEUL, 0x7BEA5C70UL), 83 },  /* 10^44 */
+    { U64(0xD5D238A4UL, 0xABE98068UL), 109 },  /* 10^52 */
+    { U64(0x9F4F2726UL, 0x179A2245UL), 136 },  /* 10^60 */
+    { U64(0xED63A231UL, 0xD4C4FB27UL), 162 },  /* 10^68 */
+    { U64(0xB0DE6538UL, 0x8CC8ADA8UL), 189 },  /* 10^76 */
+    { U64(0x83C7088EUL, 0x1AAB65DBUL), 216 },  /* 10^84 */
+    { U64(0xC45D1DF9UL, 0x42711D9AUL), 242 },  /* 10^92 */
+    { U64(0x924D692CUL, 0xA61BE758UL), 269 },  /* 10^100 */
+    { U64(0xDA01EE64UL, 0x1A708DEAUL), 295 },  /* 10^108 */
+    { U64(0xA26DA399UL, 0x9AEF774AUL), 322 },  /* 10^116 */
+    { U64(0xF209787BUL, 0xB47D6B85UL), 348 },  /* 10^124 */
+    { U64(0xB454E4A1UL, 0x79DD1877UL), 375 },  /* 10^132 */
+    { U64(0x865B8692UL, 0x5B9BC5C2UL), 402 },  /* 10^140 */
+    { U64(0xC83553C5UL, 0xC8965D3DUL), 428 },  /* 10^148 */
+    { U64(0x952AB45CUL, 0xFA97A0B3UL), 455 },  /* 10^156 */
+    { U64(0xDE469FBDUL, 0x99A05FE3UL), 481 },  /* 10^164 */
+    { U64(0xA59BC234UL, 0xDB398C25UL), 508 },  /* 10^172 */
+    { U64(0xF6C69A72UL, 0xA3989F5CUL), 534 },  /* 10^180 */
+    { U64(0xB7DCBF53UL, 0x54E9BECEUL), 561 },  /* 10^188 */
+    { U64(0x88FCF317UL, 0xF22241E2UL), 588 },  /* 10^196 */
+    { U64(0xCC20CE9BUL, 0xD35C78A5UL), 614 },  /* 10^204 */
+    { U64(0x98165AF3UL, 0x7B2153DFUL), 641 },  /* 10^212 */
+    { U64(0xE2A0B5DCUL, 0x971F303AUL), 667 },  /* 10^220 */
+    { U64(0xA8D9D153UL, 0x5CE3B396UL), 694 },  /* 10^228 */
+    { U64(0xFB9B7CD9UL, 0xA4A7443CUL), 720 },  /* 10^236 */
+    { U64(0xBB764C4CUL, 0xA7A44410UL), 747 },  /* 10^244 */
+    { U64(0x8BAB8EEFUL, 0xB6409C1AUL), 774 },  /* 10^252 */
+    { U64(0xD01FEF10UL, 0xA657842CUL), 800 },  /* 10^260 */
+    { U64(0x9B10A4E5UL, 0xE9913129UL), 827 },  /* 10^268 */
+    { U64(0xE7109BFBUL, 0xA19C0C9DUL), 853 },  /* 10^276 */
+    { U64(0xAC2820D9UL, 0x623BF429UL), 880 },  /* 10^284 */
+    { U64(0x80444B5EUL, 0x7AA7CF85UL), 907 },  /* 10^292 */
+    { U64(0xBF21E440UL, 0x03ACDD2DUL), 933 },  /* 10^300 */
+    { U64(0x8E679C2FUL, 0x5E44FF8FUL), 960 },  /* 10^308 */
+    { U64(0xD433179DUL, 0x9C8CB841UL), 986 },  /* 10^316 */
+    { U64(0x9E19DB92UL, 0xB4E31BA9UL), 1013 },  /* 10^324 */
+    { U64(0xEB96BF6EUL, 0xBADF77D9UL), 1039 },  /* 10^332 */
+    { U64(0xAF87023BUL, 0x9BF0EE6BUL), 1066 }   /* 10^340 */
+};
 
 /*  -----------  functions  ----------------------------------------------
  */
 json_node_t json_read(const char* filename) {
+    return json_read_ex(filename, JSON_OPT_DEFAULT);
+}
+
+json_node_t json_read_ex(const char* filename, unsigned int options) {
     json_node_t root = NULL;
-    json_file_t file;
-    FILE* fp = NULL;
+    char* buffer = NULL;
+    size_t length = 0;
+    int owner = SOURCE_ALLOCATED;
     errno = 0;
-    (void)memset(&file, 0, sizeof(json_file_t));
-    /* (1) open the file */
-    if ((fp = fopen(filename, "rb")) == NULL) {
+    if (!filename) {
+        set_last_error(JSON_ERR_ARGUMENT, NULL, 0);
+        errno = EINVAL;  /* FIXME: error code */
+        return NULL;
+    }
+#if (MMAP_SUPPORTED != 0)
+    /* (a) map the file into memory (if requested) */
+    if (options & JSON_OPT_MMAP) {
+        if ((buffer = map_file(filename, &length, (options & JSON_OPT_INSITU) ? 1 : 0)) != NULL)
+            owner = SOURCE_MAPPED;
+        else
+            errno = 0;  /* fall back to reading the file */
+    }
+#endif
+    /* (b) read the file into a buffer */
+    if (!buffer && ((buffer = load_file(filename, &length)) == NULL)) {
         /* errno set */
+        set_last_error((errno == ENOMEM) ? JSON_ERR_MEMORY : JSON_ERR_FILE, NULL, 0);
         return NULL;
     }
-    /* (2) determine its size */
-    if (fseek(fp, 0, SEEK_END) != 0) {
+    /* (c) parse the content of the file */
+    root = parse_buffer(buffer, length, options);
+    if (root && (options & JSON_OPT_INSITU)) {
+        /* the document keeps the buffer alive */
+        return keep_source(root, buffer, length, owner);
+    }
+    free_source(buffer, length, owner);
+    return root;
+}
+
+json_node_t json_parse(const char* buffer, jsize_t length) {
+    return json_parse_ex(buffer, length, JSON_OPT_DEFAULT);
+}
+
+json_node_t json_parse_ex(const char* buffer, jsize_t length, unsigned int options) {
+    json_node_t root = NULL;
+    char* copy = NULL;
+    errno = 0;
+    if (!buffer) {
+        set_last_error(JSON_ERR_ARGUMENT, NULL, 0);
+        errno = EINVAL;  /* FIXME: error code */
+        return NULL;
+    }
+    if (!(options & JSON_OPT_INSITU)) {
+        /* parse the content of the caller's buffer (no copy) */
+        return parse_buffer(buffer, (size_t)length, options);
+    }
+    /* in-situ: one copy of the buffer, owned by the document */
+    if ((copy = (char*)malloc((size_t)length + (size_t)1)) == NULL) {
         /* errno set */
-        (void)fclose(fp);
+        set_last_error(JSON_ERR_MEMORY, NULL, 0);
         return NULL;
     }
-    if ((file.len = ftell(fp)) < 0) {
+    (void)memcpy(copy, buffer, (size_t)length);
+    copy[length] = '\0';
+    if ((root = parse_buffer(copy, (size_t)length, options)) == NULL) {
         /* errno set */
-        (void)fclose(fp);
+        free_source(copy, (size_t)length, SOURCE_ALLOCATED);
+        return NULL;
+    }
+    return keep_source(root, copy, (size_t)length, SOURCE_ALLOCATED);
+}
+
+json_node_t json_parse_insitu(char* buffer, jsize_t length, unsigned int options) {
+    errno = 0;
+    if (!buffer) {
+        set_last_error(JSON_ERR_ARGUMENT, NULL, 0);
+        errno = EINVAL;  /* FIXME: error code */
         return NULL;
     }
-    if (fseek(fp, 0, SEEK_SET) != 0) {
+    /* in-situ: the tree borrows the caller's buffer */
+    return parse_buffer(buffer, (size_t)length, options | JSON_OPT_INSITU);
+}
+
+int json_read_events(const char* filename, const json_handler_t* handler, void* context) {
+    json_file_t file;
+    char* buffer = NULL;
+    size_t length = 0;
+    int owner = SOURCE_ALLOCATED;
+    int rc;
+    errno = 0;
+    if (!filename || !handler) {
+        set_last_error(JSON_ERR_ARGUMENT, NULL, 0);
+        errno = EINVAL;  /* FIXME: error code */
+        return (-1);
+    }
+#if (MMAP_SUPPORTED != 0)
+    /* (a) map the file into memory (read-only) */
+    if ((buffer = map_file(filename, &length, 0)) != NULL)
+        owner = SOURCE_MAPPED;
+    else
+        errno = 0;  /* fall back to reading the file */
+#endif
+    /* (b) read the file into a buffer */
+    if (!buffer && ((buffer = load_file(filename, &length)) == NULL)) {
+        /* errno set */
+        set_last_error((errno == ENOMEM) ? JSON_ERR_MEMORY : JSON_ERR_FILE, NULL, 0);
+        return (-1);
+    }
+    /* (c) report the content of the file */
+    rc = parse_stream(&file, buffer, length, handler, context);
+    free_source(buffer, length, owner);
+    return rc;
+}
+
+int json_parse_events(const char* buffer, jsize_t length, const json_handler_t* handler, void* context) {
+    json_file_t file;
+    errno = 0;
+    if (!buffer || !handler) {
+        set_last_error(JSON_ERR_ARGUMENT, NULL, 0);
+        errno = EINVAL;  /* FIXME: error code */
+        return (-1);
+    }
+    return parse_stream(&file, buffer, (size_t)length, handler, context);
+}
+
+json_parser_t json_parser_new(const json_handler_t* handler, void* context, unsigned int options) {
+    struct json_parser* parser = NULL;
+    errno = 0;
+    init_kernels();
+    if ((parser = (struct json_parser*)malloc(sizeof(struct json_parser))) == NULL) {
         /* errno set */
-        (void)fclose(fp);
         return NULL;
     }
-    /* (3) read its content into a buffer */
-    if ((file.buf = (char*)malloc((size_t)file.len + (size_t)1)) == NULL) {
+    (void)memset(parser, 0, sizeof(struct json_parser));
+    if (!handler) {
+        /* without a handler the parser builds a tree */
+        if ((parser->doc = (struct json_document*)malloc(sizeof(struct json_document))) == NULL) {
+            /* errno set */
+            free(parser);
+            return NULL;
+        }
+        arena_init(&parser->doc->arena, 0);
+        parser->doc->magic = DOCUMENT_MAGIC;
+        parser->doc->self = parser->doc;
+        parser->doc->source = NULL;
+        parser->doc->length = 0;
+        parser->doc->owner = SOURCE_BORROWED;
+        parser->file.arena = &parser->doc->arena;
+        handler = &tree_builder;
+        context = (void*)parser;
+    }
+    /* note: the text is never kept, i.e. there is no in-situ mode */
+    parser->file.options = options & ~(JSON_OPT_INSITU | JSON_OPT_MMAP);
+    parser->file.state = STATE_VALUE;
+    parser->handler = handler;
+    parser->context = context;
+    parser->line = 1;
+    parser->column = 1;
+    return (json_parser_t)parser;
+}
+
+int json_parser_feed(json_parser_t parser, const char* chunk, jsize_t length) {
+    errno = 0;
+    if (!parser || (!chunk && (length > 0)) || parser->file.final) {
+        set_last_error(JSON_ERR_ARGUMENT, NULL, 0);
+        errno = EINVAL;  /* FIXME: error code */
+        return (-1);
+    }
+    if ((parser->status != 0) || (parser->file.state == STATE_DONE)) {
+        /* stopped or failed, or the root value is complete */
+        return parser->status;
+    }
+    return feed_chunk(parser, chunk, (size_t)length);
+}
+
+int json_parser_finish(json_parser_t parser, json_node_t* root) {
+    struct json_document* doc = NULL;
+    errno = 0;
+    if (root)
+        *root = NULL;
+    if (!parser || parser->file.final) {
+        set_last_error(JSON_ERR_ARGUMENT, NULL, 0);
+        errno = EINVAL;  /* FIXME: error code */
+        return (-1);
+    }
+    parser->file.final = 1;
+    if (parser->status != 0) {
+        /* stopped or failed */
+        return parser->status;
+    }
+    /* the incomplete token (if any) is complete now */
+    if ((parser->carried > 0) && (run_buffer(parser, parser->carry, parser->carried) != 0)) {
         /* errno set */
-        (void)fclose(fp);
+        return parser->status;
+    }
+    if (parser->file.state != STATE_DONE) {
+        /* end of text within the root value (or no value at all) */
+        parser->status = (-1);
+        set_last_error(JSON_ERR_END, NULL, parser->offset);
+        last_error.line = parser->line;
+        last_error.column = parser->column;
+        errno = EINVAL;
+        return (-1);
+    }
+    if (parser->doc) {
+        /* the root node is embedded into the document */
+        doc = parser->doc;
+        parser->doc = NULL;
+        doc->root = *parser->root;
+        if (root)
+            *root = &doc->root;
+        else
+            free_document(doc);
+    }
+    set_last_error(JSON_ERR_NONE, NULL, 0);
+    return 0;
+}
+
+void json_parser_free(json_parser_t parser) {
+    int error = errno;
+    if (parser) {
+        if (parser->doc)
+            free_document(parser->doc);
+        free(parser->carry);
+        free(parser->file.stack);
+        free(parser->file.frame);
+        free(parser);
+    }
+    errno = error;
+}
+
+json_lines_t json_lines_open(const char* filename, unsigned int options, int threads) {
+    struct json_lines* lines = NULL;
+#if (THREADS_SUPPORTED != 0)
+    int i;
+#endif
+    errno = 0;
+    if (threads <= 0)
+        threads = count_processors();
+    /* more threads than processors do not help much (and two batches
+     * are held per thread), i.e. the number of threads is bounded */
+    if (threads > (count_processors() * JSON_LINES_THREADS))
+        threads = count_processors() * JSON_LINES_THREADS;
+#if (THREADS_SUPPORTED == 0)
+    threads = 1;
+#endif
+    if ((lines = (struct json_lines*)calloc(1, sizeof(struct json_lines))) == NULL) {
+        /* errno set */
+        set_last_error(JSON_ERR_MEMORY, NULL, 0);
         return NULL;
     }
-    if (fread(file.buf, sizeof(char), (size_t)file.len, fp) != (size_t)file.len) {
+    /* two batches per thread: one is parsed, one is filled or returned */
+    lines->slots = threads * 2;
+    if ((lines->batch = (struct json_batch*)calloc((size_t)lines->slots, sizeof(struct json_batch))) == NULL) {
         /* errno set */
-        free(file.buf);
-        (void)fclose(fp);
+        set_last_error(JSON_ERR_MEMORY, NULL, 0);
+        free(lines);
         return NULL;
     }
-    /* (4) close it again */
-    if (fclose(fp) != 0) {
+    if (!filename)
+        lines->fp = stdin;
+    else if ((lines->fp = fopen(filename, "rb")) == NULL) {
+        /* errno set */
+        set_last_error(JSON_ERR_FILE, NULL, 0);
+        free(lines->batch);
+        free(lines);
+        return NULL;
+    }
+    lines->options = options & ~JSON_OPT_MMAP;
+    lines->line = 1;
+    /* the kernels are selected before the threads are started */
+    init_kernels();
+#if (THREADS_SUPPORTED != 0)
+    /* the calling thread parses too, i.e. one worker thread less */
+    if ((threads > 1) &&
+        ((lines->thread = (pthread_t*)malloc((size_t)(threads - 1) * sizeof(pthread_t))) != NULL)) {
+        if (pthread_mutex_init(&lines->mutex, NULL) != 0) {
+            free(lines->thread);
+            lines->thread = NULL;
+        } else if (pthread_cond_init(&lines->ready, NULL) != 0) {
+            (void)pthread_mutex_destroy(&lines->mutex);
+            free(lines->thread);
+            lines->thread = NULL;
+        } else if (pthread_cond_init(&lines->done, NULL) != 0) {
+            (void)pthread_cond_destroy(&lines->ready);
+            (void)pthread_mutex_destroy(&lines->mutex);
+            free(lines->thread);
+            lines->thread = NULL;
+        } else {
+            /* as many worker threads as possible */
+            for (i = 0; i < (threads - 1); i++) {
+                if (pthread_create(&lines->thread[i], NULL, lines_worker, (void*)lines) != 0)
+                    break;
+                lines->threads++;
+            }
+        }
+    }
+#endif
+    errno = 0;
+    return (json_lines_t)lines;
+}
+
+int json_lines_next(json_lines_t lines, json_node_t* root) {
+    struct json_batch* batch = NULL;
+    struct json_record* record = NULL;
+    int slot;
+    errno = 0;
+    if (root)
+        *root = NULL;
+    if (!lines || !root) {
+        set_last_error(JSON_ERR_ARGUMENT, NULL, 0);
+        errno = EINVAL;  /* FIXME: error code */
+        return (-1);
+    }
+    for (;;) {
+        /* (a) fill the empty batches with the next lines of the file */
+        lines_lock(lines);
+        while (!lines->eof && (lines->batch[lines->fill].state == BATCH_EMPTY)) {
+            lines_unlock(lines);
+            batch = &lines->batch[lines->fill];
+            if (fill_batch(lines, batch) <= 0) {
+                /* end of file (or error) */
+                lines_lock(lines);
+                lines->eof = 1;
+                break;
+            }
+            lines_lock(lines);
+            batch->state = BATCH_READY;
+#if (THREADS_SUPPORTED != 0)
+            if (lines->threads > 0)
+                (void)pthread_cond_signal(&lines->ready);
+#endif
+            lines->fill = (lines->fill + 1) % lines->slots;
+        }
+        /* (b) the oldest batch is parsed here, if no thread has taken it */
+        slot = lines->head;
+        batch = &lines->batch[slot];
+        if (batch->state == BATCH_READY) {
+            take_batch(lines, slot);
+            lines_unlock(lines);
+            parse_lines(batch, lines->options);
+            lines_lock(lines);
+            batch->state = BATCH_DONE;
+        }
+#if (THREADS_SUPPORTED != 0)
+        /* (c) or wait until a thread has parsed it */
+        while ((batch->state == BATCH_BUSY) && (lines->threads > 0))
+            (void)pthread_cond_wait(&lines->done, &lines->mutex);
+#endif
+        lines_unlock(lines);
+        if (batch->state == BATCH_EMPTY) {
+            /* end of file: all batches are returned */
+            if (lines->code != 0) {
+                /* the file could not be read */
+                set_last_error(JSON_ERR_FILE, NULL, (size_t)lines->offset);
+                errno = lines->code;
+                lines->code = 0;
+                return (-1);
+            }
+            set_last_error(JSON_ERR_NONE, NULL, 0);
+            return 0;
+        }
+        assert(batch->state == BATCH_DONE);
+        /* (d) return the next line of the batch (document or error) */
+        if (batch->next < batch->count) {
+            record = &batch->record[batch->next++];
+            if (record->root) {
+                *root = record->root;
+                set_last_error(JSON_ERR_NONE, NULL, 0);
+                return 1;
+            }
+            /* the location of the error within the file */
+            last_error = record->error;
+            last_error.offset += (jsize_t)(batch->offset + record->offset);
+            if (last_error.line > 0)
+                last_error.line += lines->line + record->line - 1;
+            errno = record->code;
+            return (-1);
+        }
+        if (batch->code != 0) {
+            /* not all lines of the batch were parsed */
+            set_last_error(JSON_ERR_MEMORY, NULL, 0);
+            errno = batch->code;
+            batch->code = 0;
+            return (-1);
+        }
+        /* (e) the batch is returned, on to the next one */
+        lines->line += batch->lines;
+        lines_lock(lines);
+        batch->state = BATCH_EMPTY;
+        lines->head = (lines->head + 1) % lines->slots;
+        lines_unlock(lines);
+    }
+}
+
+void json_lines_close(json_lines_t lines) {
+    int error = errno;
+    int i;
+    if (lines) {
+#if (THREADS_SUPPORTED != 0)
+        if (lines->thread) {
+            /* stop the worker threads (after the batch at hand) */
+            lines_lock(lines);
+            lines->quit = 1;
+            (void)pthread_cond_broadcast(&lines->ready);
+            lines_unlock(lines);
+            for (i = 0; i < lines->threads; i++)
+                (void)pthread_join(lines->thread[i], NULL);
+            (void)pthread_cond_destroy(&lines->ready);
+            (void)pthread_cond_destroy(&lines->done);
+            (void)pthread_mutex_destroy(&lines->mutex);
+            free(lines->thread);
+        }
+#endif
+        for (i = 0; i < lines->slots; i++)
+            free_batch(&lines->batch[i]);
+        if (lines->fp && (lines->fp != stdin))
+            (void)fclose(lines->fp);
+        free(lines->batch);
+        free(lines->carry);
+        free(lines);
+    }
+    errno = error;
+}
+
+json_doc_t json_doc_new(unsigned int options) {
+    struct json_doc* doc = NULL;
+    errno = 0;
+    if ((doc = (struct json_doc*)malloc(sizeof(struct json_doc))) == NULL) {
         /* errno set */
-        free(file.buf);
+        set_last_error(JSON_ERR_MEMORY, NULL, 0);
+        return NULL;
+    }
+    (void)memset(doc, 0, sizeof(struct json_doc));
+    /* the arena is sized from the first text (see json_doc_parse) */
+    arena_init(&doc->doc.arena, 0);
+    doc->doc.magic = DOCUMENT_MAGIC;
+    doc->doc.self = &doc->doc;
+    doc->doc.root.type = JSON_NULL;
+    doc->doc.source = NULL;
+    doc->doc.length = 0;
+    doc->doc.owner = SOURCE_RECYCLED;
+    doc->options = options;
+    return (json_doc_t)doc;
+}
+
+json_node_t json_doc_parse(json_doc_t doc, const char* buffer, jsize_t length) {
+    const char* text = buffer;
+    json_node_t root = NULL;
+    json_file_t file;
+    char* copy = NULL;
+    int error;
+    errno = 0;
+    if (!doc || !buffer) {
+        set_last_error(JSON_ERR_ARGUMENT, NULL, 0);
+        errno = EINVAL;  /* FIXME: error code */
         return NULL;
     }
-    /* (5) parse the content of the file */
-    file.buf[file.len] = '\0';
-    if (file.len > 0) {
-        root = parse_value(&file);
+    /* (1) release the previous tree (but keep the memory) */
+    json_doc_reset(doc);
+    if (length == 0) {
+        set_last_error(JSON_ERR_END, buffer, 0);
+        errno = EINVAL;  /* FIXME: error code */
+        return NULL;
+    }
+    if (!doc->doc.arena.head)
+        arena_init(&doc->doc.arena, (size_t)length);
+    /* (2) in-situ: the text is copied into the buffer of the document */
+    if (doc->options & JSON_OPT_INSITU) {
+        if ((size_t)length >= doc->capacity) {
+            if ((copy = (char*)realloc(doc->text, (size_t)length + (size_t)1)) == NULL) {
+                /* errno set */
+                set_last_error(JSON_ERR_MEMORY, NULL, 0);
+                return NULL;
+            }
+            doc->text = copy;
+            doc->capacity = (size_t)length + (size_t)1;
+        }
+        (void)memcpy(doc->text, buffer, (size_t)length);
+        doc->text[length] = '\0';
+        text = doc->text;
     }
-    free(file.buf);
+    /* (3) parse the text with the stacks of the previous documents */
+    (void)memset(&file, 0, sizeof(json_file_t));
+    file.stack = doc->stack;
+    file.size = doc->size;
+    file.frame = doc->frame;
+    file.levels = doc->levels;
+    root = parse_tree(&file, &doc->doc, text, (size_t)length, doc->options);
+    error = errno;
+    doc->stack = file.stack;
+    doc->size = file.size;
+    doc->frame = file.frame;
+    doc->levels = file.levels;
+    errno = error;
     return root;
 }
 
+void json_doc_reset(json_doc_t doc) {
+    if (doc) {
+        arena_reset(&doc->doc.arena);
+        (void)memset(&doc->doc.root, 0, sizeof(struct json_node));
+        doc->doc.root.type = JSON_NULL;
+    }
+}
+
+void json_doc_free(json_doc_t doc) {
+    int error = errno;
+    if (doc) {
+        arena_free(&doc->doc.arena);
+        free(doc->text);
+        free(doc->stack);
+        free(doc->frame);
+        free(doc);
+    }
+    errno = error;
+}
+
 void json_free(json_node_t node) {
+    if (!node)
+        return;
+    /* only a root node can be freed: the literals are static, and the
+     * other nodes are preceded by a chunk header or by other data of the
+     * arena (e.g. a string from the text), which may look like the tag
+     * of a document, but cannot hold the address of the document */
+    if ((node == &json_true) || (node == &json_false) || (node == &json_null) ||
+        (DOCUMENT(node)->magic != DOCUMENT_MAGIC) || (DOCUMENT(node)->self != DOCUMENT(node))) {
+        errno = EINVAL;  /* FIXME: error code */
+        return;
+    }
+    if (DOCUMENT(node)->owner == SOURCE_RECYCLED) {
+        /* the tree is owned by a reusable document (see json_doc_free) */
+        errno = EINVAL;  /* FIXME: error code */
+        return;
+    }
     /* (X) get rid of all the crap */
-    free_value(node);
+    DOCUMENT(node)->magic = 0UL;
+    DOCUMENT(node)->self = NULL;
+    free_document(DOCUMENT(node));
 }
 
 json_type_t json_get_value_type(json_node_t node) {
@@ -227,10 +1971,7 @@ json_node_t json_get_value_of(const char* string, json_node_t node) {
         return NULL;
     }
     if (node->value.dict.head) {
-        curr = node->value.dict.head;
-        while ((curr != NULL) && (curr->string != NULL) && (strcmp(curr->string, string)))
-            curr = curr->next;
-        if ((curr != NULL) && (curr->string != NULL) && (!strcmp(curr->string, string)))
+        if ((curr = find_member(node, string)) != NULL)
             value = curr->value;
         else
             errno = EINVAL;  /* FIXME: error code */
@@ -240,7 +1981,6 @@ json_node_t json_get_value_of(const char* string, json_node_t node) {
 }
 
 json_node_t json_get_value_at(int index, json_node_t node) {
-    struct json_element* curr = NULL;
     struct json_node* value = NULL;
     errno = 0;
     if (!node || (index < 0)) {
@@ -251,15 +1991,14 @@ json_node_t json_get_value_at(int index, json_node_t node) {
         errno = EINVAL;  /* FIXME: error code */
         return NULL;
     }
-    if (node->value.array.head) {
-        curr = node->value.array.head;
-        while ((curr != NULL) && (curr->index != index))
-            curr = curr->next;
-        if ((curr != NULL) && (curr->index == index))
-            value = curr->value;
-        else
+    if (node->value.array.elem) {
+        if (index < node->value.array.size) {
+            value = node->value.array.elem[index];
+            node->value.array.curr = index;
+        } else {
             errno = EINVAL;  /* FIXME: error code */
-        node->value.array.curr = curr;
+            node->value.array.curr = (-1);
+        }
     }
     return value;
 }
@@ -276,9 +2015,9 @@ json_node_t json_get_value_first(json_node_t node) {
         if (node->value.dict.curr)
             value = node->value.dict.curr->value;
     } else if (node->type == JSON_ARRAY) {
-        node->value.array.curr = node->value.array.head;
-        if (node->value.array.curr)
-            value = node->value.array.curr->value;
+        node->value.array.curr = (node->value.array.size > 0) ? 0 : (-1);
+        if (node->value.array.curr >= 0)
+            value = node->value.array.elem[node->value.array.curr];
     } else {
         errno = EINVAL;  /* FIXME: error code */
     }
@@ -298,10 +2037,12 @@ json_node_t json_get_value_next(json_node_t node) {
         if (node->value.dict.curr)
             value = node->value.dict.curr->value;
     } else if (node->type == JSON_ARRAY) {
-        if (node->value.array.curr)
-            node->value.array.curr = node->value.array.curr->next;
-        if (node->value.array.curr)
-            value = node->value.array.curr->value;
+        if (node->value.array.curr >= 0)
+            node->value.array.curr++;
+        if (node->value.array.curr >= node->value.array.size)
+            node->value.array.curr = (-1);
+        if (node->value.array.curr >= 0)
+            value = node->value.array.elem[node->value.array.curr];
     } else {
         errno = EINVAL;  /* FIXME: error code */
     }
@@ -331,66 +2072,187 @@ int json_get_array_index(json_node_t node) {
         return (-1);
     }
     if (node->type == JSON_ARRAY) {
-        if (node->value.array.curr)
-            index = node->value.array.curr->index;
+        index = node->value.array.curr;
     } else {
         errno = EINVAL;  /* FIXME: error code */
     }
     return index;
 }
 
-char* json_get_string(json_node_t node, char* buffer, jsize_t length) {
-    jsize_t i = (jsize_t)0;
+int json_get_array_size(json_node_t node) {
     errno = 0;
     if (!node) {
         errno = EINVAL;  /* FIXME: error code */
-        return NULL;
+        return (-1);
     }
-    if (node->type != JSON_STRING) {
+    if (node->type != JSON_ARRAY) {
+        errno = EINVAL;  /* FIXME: error code */
+        return (-1);
+    }
+    return node->value.array.size;
+}
+
+json_node_t json_find_value_of(const char* string, const struct json_node* node) {
+    struct json_member* curr = NULL;
+    errno = 0;
+    if (!node || !string) {
         errno = EINVAL;  /* FIXME: error code */
         return NULL;
     }
-    if (!node->value.string) {
+    if (node->type != JSON_OBJECT) {
         errno = EINVAL;  /* FIXME: error code */
         return NULL;
     }
-    if (buffer && (length > 0UL)) {
-        do {
-            buffer[i] = node->value.string[i];
-            i++;
-        } while ((node->value.string[(i - 1)] != '\0') && (i < length));
-        buffer[(length - 1)] = '\0';
+    if (node->value.dict.head) {
+        if ((curr = find_member(node, string)) != NULL)
+            return curr->value;
+        errno = EINVAL;  /* FIXME: error code */
     }
-    return node->value.string;
+    return NULL;
 }
 
-char* json_get_number(json_node_t node, char* buffer, jsize_t length) {
-    jsize_t i = (jsize_t)0;
+json_node_t json_find_value_at(int index, const struct json_node* node) {
     errno = 0;
-    if (!node) {
+    if (!node || (index < 0)) {
         errno = EINVAL;  /* FIXME: error code */
         return NULL;
     }
-    if (node->type != JSON_NUMBER) {
+    if (node->type != JSON_ARRAY) {
         errno = EINVAL;  /* FIXME: error code */
         return NULL;
     }
-    if (!node->value.string) {
+    if (node->value.array.elem) {
+        if (index < node->value.array.size)
+            return node->value.array.elem[index];
         errno = EINVAL;  /* FIXME: error code */
-        return NULL;
     }
-    if (buffer && (length > 0UL)) {
-        do {
-            buffer[i] = node->value.string[i];
-            i++;
+    return NULL;
+}
+
+int json_iter_init(json_iter_t* iter, const struct json_node* node) {
+    errno = 0;
+    if (!iter || !node) {
+        errno = EINVAL;  /* FIXME: error code */
+        return (-1);
+    }
+    if ((node->type != JSON_OBJECT) && (node->type != JSON_ARRAY)) {
+        errno = EINVAL;  /* FIXME: error code */
+        return (-1);
+    }
+    iter->node = node;
+    iter->member = NULL;
+    iter->index = (-1);
+    return 0;
+}
+
+json_node_t json_iter_next(json_iter_t* iter) {
+    const struct json_node* node = NULL;
+    errno = 0;
+    if (!iter || !iter->node) {
+        errno = EINVAL;  /* FIXME: error code */
+        return NULL;
+    }
+    node = iter->node;
+    /* note: at the end the index is one past the last member resp. element */
+    if (node->type == JSON_OBJECT) {
+        if (iter->index < 0)
+            iter->member = node->value.dict.head;
+        else if (iter->member)
+            iter->member = iter->member->next;
+        else
+            return NULL;
+        iter->index++;
+        return iter->member ? iter->member->value : NULL;
+    } else if (node->type == JSON_ARRAY) {
+        if (iter->index < node->value.array.size)
+            iter->index++;
+        return (iter->index < node->value.array.size) ? node->value.array.elem[iter->index] : NULL;
+    }
+    errno = EINVAL;  /* FIXME: error code */
+    return NULL;
+}
+
+const char* json_iter_key(const json_iter_t* iter) {
+    errno = 0;
+    if (!iter || !iter->node) {
+        errno = EINVAL;  /* FIXME: error code */
+        return NULL;
+    }
+    if (iter->node->type != JSON_OBJECT) {
+        errno = EINVAL;  /* FIXME: error code */
+        return NULL;
+    }
+    return iter->member ? iter->member->string : NULL;
+}
+
+int json_iter_index(const json_iter_t* iter) {
+    errno = 0;
+    if (!iter || !iter->node) {
+        errno = EINVAL;  /* FIXME: error code */
+        return (-1);
+    }
+    if (iter->node->type == JSON_OBJECT)
+        return iter->member ? iter->index : (-1);
+    if (iter->node->type == JSON_ARRAY)
+        return (iter->index < iter->node->value.array.size) ? iter->index : (-1);
+    errno = EINVAL;  /* FIXME: error code */
+    return (-1);
+}
+
+char* json_get_string(json_node_t node, char* buffer, jsize_t length) {
+    jsize_t i = (jsize_t)0;
+    errno = 0;
+    if (!node) {
+        errno = EINVAL;  /* FIXME: error code */
+        return NULL;
+    }
+    if (node->type != JSON_STRING) {
+        errno = EINVAL;  /* FIXME: error code */
+        return NULL;
+    }
+    if (!node->value.string) {
+        errno = EINVAL;  /* FIXME: error code */
+        return NULL;
+    }
+    if (buffer && (length > 0UL)) {
+        do {
+            buffer[i] = node->value.string[i];
+            i++;
         } while ((node->value.string[(i - 1)] != '\0') && (i < length));
         buffer[(length - 1)] = '\0';
     }
     return node->value.string;
 }
 
+char* json_get_number(json_node_t node, char* buffer, jsize_t length) {
+    jsize_t i = (jsize_t)0;
+    errno = 0;
+    if (!node) {
+        errno = EINVAL;  /* FIXME: error code */
+        return NULL;
+    }
+    if (node->type != JSON_NUMBER) {
+        errno = EINVAL;  /* FIXME: error code */
+        return NULL;
+    }
+    if (!node->value.number.string) {
+        errno = EINVAL;  /* FIXME: error code */
+        return NULL;
+    }
+    if (buffer && (length > 0UL)) {
+        do {
+            buffer[i] = node->value.number.string[i];
+            i++;
+        } while ((node->value.number.string[(i - 1)] != '\0') && (i < length));
+        buffer[(length - 1)] = '\0';
+    }
+    return node->value.number.string;
+}
+
 long json_get_integer(json_node_t node, char* buffer, jsize_t length) {
+    struct json_number number;
     jsize_t i = (jsize_t)0;
+    jint64_t value;
     errno = 0;
     if (!node) {
         errno = EINVAL;  /* FIXME: error code */
@@ -400,20 +2262,33 @@ long json_get_integer(json_node_t node, char* buffer, jsize_t length) {
         errno = EINVAL;  /* FIXME: error code */
         return 0L;
     }
-    if (!node->value.string) {
+    if (!node->value.number.string) {
         errno = EINVAL;  /* FIXME: error code */
         return 0L;
     }
     if (buffer && (length > 0UL)) {
         do {
-            buffer[i] = node->value.string[i];
+            buffer[i] = node->value.number.string[i];
             i++;
-        } while ((node->value.string[(i - 1)] != '\0') && (i < length));
+        } while ((node->value.number.string[(i - 1)] != '\0') && (i < length));
         buffer[(length - 1)] = '\0';
     }
-    return atol(node->value.string);
+    number = node->value.number;
+    if (!number.flags)
+        decode_number(&number, number.string);
+    value = number_int64(&number);
+    if (value > (jint64_t)LONG_MAX) {
+        errno = ERANGE;
+        return LONG_MAX;
+    }
+    if (value < (jint64_t)LONG_MIN) {
+        errno = ERANGE;
+        return LONG_MIN;
+    }
+    return (long)value;
 }
 double json_get_float(json_node_t node, char* buffer, jsize_t length) {
+    struct json_number number;
     jsize_t i = (jsize_t)0;
     errno = 0;
     if (!node) {
@@ -424,18 +2299,91 @@ double json_get_float(json_node_t node, char* buffer, jsize_t length) {
         errno = EINVAL;  /* FIXME: error code */
         return 0.0;
     }
-    if (!node->value.string) {
+    if (!node->value.number.string) {
         errno = EINVAL;  /* FIXME: error code */
         return 0.0;
     }
     if (buffer && (length > 0UL)) {
         do {
-            buffer[i] = node->value.string[i];
+            buffer[i] = node->value.number.string[i];
             i++;
-        } while ((node->value.string[(i - 1)] != '\0') && (i < length));
+        } while ((node->value.number.string[(i - 1)] != '\0') && (i < length));
         buffer[(length - 1)] = '\0';
     }
-    return atof(node->value.string);
+    number = node->value.number;
+    if (!number.flags)
+        decode_number(&number, number.string);
+    return number_double(&number);
+}
+
+jint64_t json_get_int64(json_node_t node) {
+    struct json_number number;
+    errno = 0;
+    if (!node) {
+        errno = EINVAL;  /* FIXME: error code */
+        return 0;
+    }
+    if ((node->type != JSON_NUMBER) || !node->value.number.string) {
+        errno = EINVAL;  /* FIXME: error code */
+        return 0;
+    }
+    number = node->value.number;
+    if (!number.flags)
+        decode_number(&number, number.string);
+    return number_int64(&number);
+}
+
+double json_get_double(json_node_t node) {
+    struct json_number number;
+    errno = 0;
+    if (!node) {
+        errno = EINVAL;  /* FIXME: error code */
+        return 0.0;
+    }
+    if ((node->type != JSON_NUMBER) || !node->value.number.string) {
+        errno = EINVAL;  /* FIXME: error code */
+        return 0.0;
+    }
+    number = node->value.number;
+    if (!number.flags)
+        decode_number(&number, number.string);
+    return number_double(&number);
+}
+
+int json_format_double(double value, char* buffer, jsize_t size) {
+    char text[DOUBLE_LENGTH];
+    int length;
+    errno = 0;
+    if (!buffer || ((double_bits(value) & DOUBLE_INFINITY) == DOUBLE_INFINITY)) {
+        errno = EINVAL;  /* FIXME: error code */
+        return (-1);
+    }
+    length = format_double(value, text);
+    if ((jsize_t)length >= size) {
+        if (size > 0U)
+            buffer[0] = '\0';
+        errno = ERANGE;
+        return (-1);
+    }
+    (void)memcpy(buffer, text, (size_t)length + 1U);
+    return length;
+}
+
+int json_get_number_flags(json_node_t node) {
+    struct json_number number;
+    errno = 0;
+    if (!node) {
+        errno = EINVAL;  /* FIXME: error code */
+        return 0;
+    }
+    if ((node->type != JSON_NUMBER) || !node->value.number.string) {
+        errno = EINVAL;  /* FIXME: error code */
+        return 0;
+    }
+    number = node->value.number;
+    if (!number.flags)
+        decode_number(&number, number.string);
+    return number.flags;
 }
 
 int json_get_bool(json_node_t node, char* buffer, jsize_t length) {
@@ -488,317 +2436,2839 @@ void* json_get_null(json_node_t node, char* buffer, jsize_t length) {
     return NULL;
 }
 
-void json_dump(json_node_t node, const char* filename) {
-    FILE* fp = NULL;
+int json_get_last_error(json_error_t* error) {
+    if (error)
+        *error = last_error;
+    return last_error.reason;
+}
+
+json_tape_t json_tape_read(const char* filename, unsigned int options) {
+    struct json_tape* tape = NULL;
+    char* buffer = NULL;
+    size_t length = 0;
+    int owner = SOURCE_ALLOCATED;
+    int error;
     errno = 0;
-    if (filename) {
-        if ((fp = fopen(filename, "w")) == NULL) {
-            /* errno set */
-            return;
-        }
-        dump_value(node, (-1), fp);
-        fputc('\n', fp); fflush(fp);
-        (void)fclose(fp);
-    } else {
-        dump_value(node, (-1), stdout);
-        putchar('\n');
+    if (!filename) {
+        set_last_error(JSON_ERR_ARGUMENT, NULL, 0);
+        errno = EINVAL;  /* FIXME: error code */
+        return NULL;
     }
-    return;
+#if (MMAP_SUPPORTED != 0)
+    /* (a) map the file into memory (read-only) */
+    if ((buffer = map_file(filename, &length, 0)) != NULL)
+        owner = SOURCE_MAPPED;
+    else
+        errno = 0;  /* fall back to reading the file */
+#endif
+    /* (b) read the file into a buffer */
+    if (!buffer && ((buffer = load_file(filename, &length)) == NULL)) {
+        /* errno set */
+        set_last_error((errno == ENOMEM) ? JSON_ERR_MEMORY : JSON_ERR_FILE, NULL, 0);
+        return NULL;
+    }
+    /* (c) record the content of the file (the strings are copied) */
+    tape = tape_buffer(buffer, length, options);
+    error = errno;
+    free_source(buffer, length, owner);
+    errno = error;
+    return (json_tape_t)tape;
 }
 
-/*  -----------  local functions  ----------------------------------------
- */
-static char get_char(JSON json) {
-    assert(json);
-    assert(json->buf);
-    assert(json->len >= 1);
-    assert(json->pos <= json->len);
-    if (json->pos < json->len) {
-        if (json->buf[json->pos] == '\n') {
-            json->col = 0;
-            json->row++;
-        } else if (json->buf[json->pos] == '\t') {
-            json->col = ((json->col % TAB_SIZE) + 1) * TAB_SIZE;
-        } else {
-            json->col++;
-        }
-        return json->buf[json->pos++];
+json_tape_t json_tape_parse(const char* buffer, jsize_t length, unsigned int options) {
+    errno = 0;
+    if (!buffer) {
+        set_last_error(JSON_ERR_ARGUMENT, NULL, 0);
+        errno = EINVAL;  /* FIXME: error code */
+        return NULL;
     }
-    return 0;
+    return (json_tape_t)tape_buffer(buffer, (size_t)length, options);
 }
 
-/*  <whitespace> : ' ' | '\n' | '\r' | '\t'
- *               ;
- */
-static char lookahead(JSON json) {
-    assert(json);
-    assert(json->buf);
-    assert(json->len >= 1);
-    assert(json->pos <= json->len);
-    while ((json->pos < json->len) &&
-          ((json->buf[json->pos] == ' ') || (json->buf[json->pos] == '\n') ||
-          (json->buf[json->pos] == '\r') || (json->buf[json->pos] == '\t'))) {
-        if (json->buf[json->pos] == '\n') {
-            json->col = 0;
-            json->row++;
-        } else if (json->buf[json->pos] == '\t') {
-            json->col = ((json->col % TAB_SIZE) + 1) * TAB_SIZE;
-        } else {
-            json->col++;
-        }
-        json->pos++;
+void json_tape_free(json_tape_t tape) {
+    int error = errno;
+    if (tape) {
+        free(tape->word);
+        free(tape->string);
+        free(tape);
     }
-    return json->buf[json->pos];
+    errno = error;
 }
 
-/*  <value>      : <object>
- *               | <array>
- *               | <string>
- *               | <number>
- *               | "true"
- *               | "false"
- *               | "null"
- *               ;
- */
-static json_node_t parse_value(JSON json) {
-    char ch = lookahead(json);
-    switch (ch) {
-    case '{':
-        return parse_object(json);
-    case '[':
-        return parse_array(json);
-    case '"':
-        return parse_string(json);
-    case '-':
-    case '0': case '1': case '2':  case '3': case '4':
-    case '5': case '6': case '7':  case '8': case '9':
-        return parse_number(json);
-    case 't':
-        return parse_literal(json, JSON_TRUE);
-    case 'f':
-        return parse_literal(json, JSON_FALSE);
-    case 'n':
-        return parse_literal(json, JSON_NULL);
+json_handle_t json_tape_get_root(json_tape_t tape) {
+    errno = 0;
+    if (!tape || (tape->count == 0)) {
+        errno = EINVAL;  /* FIXME: error code */
+        return JSON_HANDLE_NONE;
+    }
+    return (json_handle_t)0;
+}
+
+json_type_t json_tape_get_value_type(json_tape_t tape, json_handle_t value) {
+    errno = 0;
+    if (!tape || (value >= (json_handle_t)tape->count)) {
+        errno = EINVAL;  /* FIXME: error code */
+        return JSON_ERROR;
+    }
+    switch (TAPE_TAG(tape->word[value])) {
+    case TAPE_OBJECT: return JSON_OBJECT;
+    case TAPE_ARRAY: return JSON_ARRAY;
+    case TAPE_STRING: return JSON_STRING;
+    case TAPE_NUMBER: return JSON_NUMBER;
+    case TAPE_TRUE: return JSON_TRUE;
+    case TAPE_FALSE: return JSON_FALSE;
+    case TAPE_NULL: return JSON_NULL;
     default:
+        /* not a value (key or end of a container) */
         errno = EINVAL;  /* FIXME: error code */
-        return NULL;
+        return JSON_ERROR;
     }
 }
 
-static void free_value(json_node_t node) {
-    if (node) {
-        switch (node->type) {
-        case JSON_OBJECT: free_object(node); break;
-        case JSON_ARRAY: free_array(node); break;
-        case JSON_STRING: free_string(node); break;
-        case JSON_NUMBER: free_number(node); break;
-        case JSON_TRUE: free_literal(node); break;
-        case JSON_FALSE: free_literal(node); break;
-        case JSON_NULL: free_literal(node); break;
-        default: break;
-        }
+json_handle_t json_tape_get_value_of(json_tape_t tape, const char* string, json_handle_t value) {
+    size_t curr;
+    errno = 0;
+    if (!tape || !string || (value >= (json_handle_t)tape->count)) {
+        errno = EINVAL;  /* FIXME: error code */
+        return JSON_HANDLE_NONE;
+    }
+    if (TAPE_TAG(tape->word[value]) != TAPE_OBJECT) {
+        errno = EINVAL;  /* FIXME: error code */
+        return JSON_HANDLE_NONE;
+    }
+    /* note: the members are searched linearly, but each value
+     *       (even an object or an array) is skipped at once */
+    for (curr = (size_t)value + 1U; TAPE_TAG(tape->word[curr]) == TAPE_KEY; curr = tape_skip(tape, curr + 1U)) {
+        if (!strcmp(&tape->string[TAPE_OFFSET(tape->word[curr])], string))
+            return (json_handle_t)(curr + 1U);
     }
+    errno = EINVAL;  /* FIXME: error code */
+    return JSON_HANDLE_NONE;
 }
 
-static void dump_value(json_node_t node, int depth, FILE* fp) {
-    if (node) {
-        switch (node->type) {
-        case JSON_OBJECT: dump_object(node, depth + 1, fp); break;
-        case JSON_ARRAY: dump_array(node, depth + 1, fp); break;
-        case JSON_STRING: dump_string(node, depth + 1, fp); break;
-        case JSON_NUMBER: dump_number(node, depth + 1, fp); break;
-        case JSON_TRUE: dump_literal(node, depth + 1, fp); break;
-        case JSON_FALSE: dump_literal(node, depth + 1, fp); break;
-        case JSON_NULL: dump_literal(node, depth + 1, fp); break;
-        default: break;
-        }
+json_handle_t json_tape_get_value_at(json_tape_t tape, int index, json_handle_t value) {
+    size_t curr;
+    errno = 0;
+    if (!tape || (index < 0) || (value >= (json_handle_t)tape->count)) {
+        errno = EINVAL;  /* FIXME: error code */
+        return JSON_HANDLE_NONE;
+    }
+    if (TAPE_TAG(tape->word[value]) != TAPE_ARRAY) {
+        errno = EINVAL;  /* FIXME: error code */
+        return JSON_HANDLE_NONE;
+    }
+    for (curr = (size_t)value + 1U; TAPE_TAG(tape->word[curr]) != TAPE_END; curr = tape_skip(tape, curr)) {
+        if (index-- == 0)
+            return (json_handle_t)curr;
     }
+    errno = EINVAL;  /* FIXME: error code */
+    return JSON_HANDLE_NONE;
 }
 
-/*  <object>     : '{' '}'
- *               | '{' <members> '}'
- *               ;
- *  <members>    : <member>
- *               | <member> ',' <members>
- *               ;
- *  <member>     : <string> ':' <value>
- *               ;
- */
-static json_node_t parse_object(JSON json) {
-    struct json_node* node = NULL;
-    struct json_node* value = NULL;
-    struct json_member* curr = NULL;
-    struct json_member* next = NULL;
-    char* string = NULL;
-    assert(json);
-    if (get_char(json) != '{') {
-        errno = EINVAL; /* FIXME: error code */
+json_handle_t json_tape_get_value_first(json_tape_t tape, json_handle_t value) {
+    size_t curr;
+    errno = 0;
+    if (!tape || (value >= (json_handle_t)tape->count)) {
+        errno = EINVAL;  /* FIXME: error code */
+        return JSON_HANDLE_NONE;
+    }
+    if ((TAPE_TAG(tape->word[value]) != TAPE_OBJECT) && (TAPE_TAG(tape->word[value]) != TAPE_ARRAY)) {
+        errno = EINVAL;  /* FIXME: error code */
+        return JSON_HANDLE_NONE;
+    }
+    curr = (size_t)value + 1U;
+    if (TAPE_TAG(tape->word[curr]) == TAPE_KEY)
+        curr++;  /* the value of the first member */
+    return (TAPE_TAG(tape->word[curr]) != TAPE_END) ? (json_handle_t)curr : JSON_HANDLE_NONE;
+}
+
+json_handle_t json_tape_get_value_next(json_tape_t tape, json_handle_t value) {
+    size_t curr;
+    errno = 0;
+    if (!tape || (value >= (json_handle_t)tape->count)) {
+        errno = EINVAL;  /* FIXME: error code */
+        return JSON_HANDLE_NONE;
+    }
+    if ((TAPE_TAG(tape->word[value]) == TAPE_KEY) || (TAPE_TAG(tape->word[value]) == TAPE_END)) {
+        errno = EINVAL;  /* FIXME: error code */
+        return JSON_HANDLE_NONE;
+    }
+    curr = tape_skip(tape, (size_t)value);
+    if (TAPE_TAG(tape->word[curr]) == TAPE_KEY)
+        curr++;  /* the value of the next member */
+    return (TAPE_TAG(tape->word[curr]) != TAPE_END) ? (json_handle_t)curr : JSON_HANDLE_NONE;
+}
+
+const char* json_tape_get_object_string(json_tape_t tape, json_handle_t value) {
+    errno = 0;
+    if (!tape || (value == 0) || (value >= (json_handle_t)tape->count)) {
+        errno = EINVAL;  /* FIXME: error code */
         return NULL;
     }
-    if ((node = (struct json_node*)malloc(sizeof(struct json_node))) == NULL) {
-        /* errno set */
+    /* note: a member value is always preceded by its key */
+    if (TAPE_TAG(tape->word[value - 1U]) != TAPE_KEY) {
+        errno = EINVAL;  /* FIXME: error code */
         return NULL;
     }
-    node->type = JSON_OBJECT;
-    node->value.dict.head = NULL;
-    node->value.dict.curr = NULL;
-    /* get member (optional) */
-    if ((string = get_string(json)) != NULL) {
-        if (lookahead(json) == '\0') {
-            free(string);
-            free(node);
-            errno = EINVAL; /* FIXME: error code */
-            return NULL;
-        }
-        if (get_char(json) != ':') {
-            free(string);
-            free(node);
-            errno = EINVAL; /* FIXME: error code */
-            return NULL;
-        }
-        /* get member value (as JSON value) */
-        value = parse_value(json);
-        if (value == NULL) {
-            /* errno set */
-            free(string);
-            free(node);
-            return NULL;
-        }
-        if ((curr = (struct json_member*)malloc(sizeof(struct json_member))) == NULL) {
-            /* errno set */
-            free_value(value);
-            free(string);
-            free(node);
-            return NULL;
-        }
-        curr->string = string;
-        curr->value = value;
-        curr->next = NULL;
-        node->value.dict.head = curr;
-        /* loop over obect members, if more */
-        while (lookahead(json) == ',') {
-            if (get_char(json) != ',') {
-                free_object(node);
-                errno = EINVAL; /* FIXME: error code */
-                return NULL;
-            }
-            /* get member key (as string) */
-            string = get_string(json);
-            if (string == NULL) {
-                /* errno set */
-                free_object(node);
-                return NULL;
-            }
-            if (lookahead(json) == '\0') {
-                free(string);
-                free_object(node);
-                errno = EINVAL; /* FIXME: error code */
-                return NULL;
-            }
-            if (get_char(json) != ':') {
-                free(string);
-                free_object(node);
-                errno = EINVAL; /* FIXME: error code */
+    return &tape->string[TAPE_OFFSET(tape->word[value - 1U])];
+}
+
+int json_tape_get_size(json_tape_t tape, json_handle_t value) {
+    json_word_t word;
+    errno = 0;
+    if (!tape || (value >= (json_handle_t)tape->count)) {
+        errno = EINVAL;  /* FIXME: error code */
+        return (-1);
+    }
+    word = tape->word[value];
+    if ((TAPE_TAG(word) != TAPE_OBJECT) && (TAPE_TAG(word) != TAPE_ARRAY)) {
+        errno = EINVAL;  /* FIXME: error code */
+        return (-1);
+    }
+    /* the number of members or elements is kept at the end */
+    return (int)TAPE_OFFSET(tape->word[TAPE_OFFSET(word)]);
+}
+
+const char* json_tape_get_string(json_tape_t tape, json_handle_t value) {
+    errno = 0;
+    if (!tape || (value >= (json_handle_t)tape->count)) {
+        errno = EINVAL;  /* FIXME: error code */
+        return NULL;
+    }
+    if (TAPE_TAG(tape->word[value]) != TAPE_STRING) {
+        errno = EINVAL;  /* FIXME: error code */
+        return NULL;
+    }
+    return &tape->string[TAPE_OFFSET(tape->word[value])];
+}
+
+const char* json_tape_get_number(json_tape_t tape, json_handle_t value) {
+    errno = 0;
+    if (!tape || (value >= (json_handle_t)tape->count)) {
+        errno = EINVAL;  /* FIXME: error code */
+        return NULL;
+    }
+    if (TAPE_TAG(tape->word[value]) != TAPE_NUMBER) {
+        errno = EINVAL;  /* FIXME: error code */
+        return NULL;
+    }
+    return &tape->string[TAPE_OFFSET(tape->word[value])];
+}
+
+jint64_t json_tape_get_int64(json_tape_t tape, json_handle_t value) {
+    struct json_number number;
+    errno = 0;
+    if (!tape || (value >= (json_handle_t)tape->count)) {
+        errno = EINVAL;  /* FIXME: error code */
+        return 0;
+    }
+    if (TAPE_TAG(tape->word[value]) != TAPE_NUMBER) {
+        errno = EINVAL;  /* FIXME: error code */
+        return 0;
+    }
+    tape_decode(tape, (size_t)value, &number);
+    return number_int64(&number);
+}
+
+double json_tape_get_double(json_tape_t tape, json_handle_t value) {
+    struct json_number number;
+    errno = 0;
+    if (!tape || (value >= (json_handle_t)tape->count)) {
+        errno = EINVAL;  /* FIXME: error code */
+        return 0.0;
+    }
+    if (TAPE_TAG(tape->word[value]) != TAPE_NUMBER) {
+        errno = EINVAL;  /* FIXME: error code */
+        return 0.0;
+    }
+    tape_decode(tape, (size_t)value, &number);
+    return number_double(&number);
+}
+
+int json_tape_get_bool(json_tape_t tape, json_handle_t value) {
+    errno = 0;
+    if (!tape || (value >= (json_handle_t)tape->count)) {
+        errno = EINVAL;  /* FIXME: error code */
+        return 0;
+    }
+    if ((TAPE_TAG(tape->word[value]) != TAPE_TRUE) && (TAPE_TAG(tape->word[value]) != TAPE_FALSE)) {
+        errno = EINVAL;  /* FIXME: error code */
+        return 0;
+    }
+    return (TAPE_TAG(tape->word[value]) == TAPE_TRUE) ? 1 : 0;
+}
+
+json_path_t json_path_compile(const char* pointer) {
+    struct json_path* path = NULL;
+    char* string = NULL;
+    size_t length, count, i;
+    errno = 0;
+    if (!pointer || ((pointer[0] != '\0') && (pointer[0] != '/'))) {
+        errno = EINVAL;  /* FIXME: error code */
+        return NULL;
+    }
+    /* note: the keys are not longer than the pointer, i.e. one block
+     *       of memory holds the path, its tokens and the unescaped keys */
+    length = strlen(pointer);
+    for (count = 0U, i = 0U; i < length; i++)
+        if (pointer[i] == '/')
+            count++;
+    if ((path = (struct json_path*)malloc(sizeof(struct json_path) + (count * sizeof(struct json_token)) + length + 1U)) == NULL) {
+        /* errno set */
+        return NULL;
+    }
+    path->token = (struct json_token*)(path + 1);
+    path->count = count;
+    string = (char*)(path->token + count);
+    for (i = 0U; i < count; i++) {
+        path->token[i].string = string;
+        pointer++;  /* skip the '/' */
+        while ((*pointer != '\0') && (*pointer != '/')) {
+            if (*pointer == '~') {
+                if (pointer[1] == '0')
+                    *string++ = '~';
+                else if (pointer[1] == '1')
+                    *string++ = '/';
+                else {
+                    free(path);
+                    errno = EINVAL;  /* FIXME: error code */
+                    return NULL;
+                }
+                pointer += 2;
+            } else
+                *string++ = *pointer++;
+        }
+        *string++ = '\0';
+        path->token[i].hash = hash_string(path->token[i].string);
+        path->token[i].index = path_index(path->token[i].string);
+    }
+    return (json_path_t)path;
+}
+
+void json_path_free(json_path_t path) {
+    free(path);
+}
+
+json_node_t json_path_get(json_path_t path, json_node_t node) {
+    size_t i;
+    errno = 0;
+    if (!path || !node) {
+        errno = EINVAL;  /* FIXME: error code */
+        return NULL;
+    }
+    for (i = 0U; i < path->count; i++) {
+        if ((node = path_step(node, &path->token[i])) == NULL) {
+            errno = EINVAL;  /* FIXME: error code */
+            return NULL;
+        }
+    }
+    return node;
+}
+
+int json_path_get_all(const json_path_t* paths, int count, json_node_t node, json_node_t* values) {
+    struct json_lookup* lookup = NULL;
+    json_node_t* trail = NULL;
+    size_t depth = 0U, known = 0U, j;
+    int found = 0, i;
+    errno = 0;
+    if (!paths || (count < 0) || !node || !values) {
+        errno = EINVAL;  /* FIXME: error code */
+        return (-1);
+    }
+    for (i = 0; i < count; i++) {
+        if (!paths[i]) {
+            errno = EINVAL;  /* FIXME: error code */
+            return (-1);
+        }
+        if (paths[i]->count > depth)
+            depth = paths[i]->count;
+    }
+    if (count == 0)
+        return 0;
+    if ((lookup = (struct json_lookup*)malloc((size_t)count * sizeof(struct json_lookup))) == NULL) {
+        /* errno set */
+        return (-1);
+    }
+    if ((trail = (json_node_t*)malloc((depth + 1U) * sizeof(json_node_t))) == NULL) {
+        /* errno set */
+        free(lookup);
+        return (-1);
+    }
+    for (i = 0; i < count; i++) {
+        lookup[i].path = paths[i];
+        lookup[i].slot = i;
+    }
+    /* note: after sorting, paths with a common prefix are adjacent; the nodes
+     *       on the previous path (the trail) are reused up to the common prefix */
+    qsort(lookup, (size_t)count, sizeof(struct json_lookup), path_compare);
+    trail[0] = node;
+    for (i = 0; i < count; i++) {
+        j = (i > 0) ? path_prefix(lookup[i].path, lookup[i - 1].path) : 0U;
+        if (j > known)
+            j = known;
+        while ((j < lookup[i].path->count) && (trail[j] != NULL)) {
+            trail[j + 1U] = path_step(trail[j], &lookup[i].path->token[j]);
+            j++;
+        }
+        known = j;
+        if ((j == lookup[i].path->count) && (trail[j] != NULL)) {
+            values[lookup[i].slot] = trail[j];
+            found++;
+        } else
+            values[lookup[i].slot] = NULL;
+    }
+    free(trail);
+    free(lookup);
+    return found;
+}
+
+json_handle_t json_path_get_handle(json_path_t path, json_tape_t tape, json_handle_t value) {
+    size_t i;
+    errno = 0;
+    if (!path || !tape || (value >= (json_handle_t)tape->count)) {
+        errno = EINVAL;  /* FIXME: error code */
+        return JSON_HANDLE_NONE;
+    }
+    for (i = 0U; (i < path->count) && (value != JSON_HANDLE_NONE); i++) {
+        switch (TAPE_TAG(tape->word[value])) {
+        case TAPE_OBJECT:
+            value = json_tape_get_value_of(tape, path->token[i].string, value);
+            break;
+        case TAPE_ARRAY:
+            value = (path->token[i].index >= 0) ? json_tape_get_value_at(tape, path->token[i].index, value) : JSON_HANDLE_NONE;
+            break;
+        default:
+            value = JSON_HANDLE_NONE;
+            break;
+        }
+    }
+    if (value == JSON_HANDLE_NONE)
+        errno = EINVAL;  /* FIXME: error code */
+    return value;
+}
+
+void json_dump(json_node_t node, const char* filename) {
+    errno = 0;
+    (void)dump_file(node, filename, JSON_INDENT_DEFAULT);
+    return;
+}
+
+int json_dump_ex(json_node_t node, const char* filename, int indent) {
+    errno = 0;
+    if (indent < 0) {
+        errno = EINVAL;  /* FIXME: error code */
+        return (-1);
+    }
+    return dump_file(node, filename, indent);
+}
+
+char* json_dump_to_buffer(json_node_t node, int indent, jsize_t* length) {
+    struct json_writer writer;
+    errno = 0;
+    if (!node || (indent < 0)) {
+        errno = EINVAL;  /* FIXME: error code */
+        return NULL;
+    }
+    (void)memset(&writer, 0, sizeof(struct json_writer));
+    writer.indent = indent;
+    writer.grow = 1;
+    if ((writer.buffer = (char*)malloc(WRITE_SIZE_MIN)) == NULL) {
+        /* errno set */
+        return NULL;
+    }
+    writer.size = WRITE_SIZE_MIN - 1U;
+    dump_value(node, (-1), &writer);
+    if (writer.error) {
+        free(writer.buffer);
+        errno = writer.error;
+        return NULL;
+    }
+    writer.buffer[writer.length] = '\0';
+    if (length)
+        *length = (jsize_t)writer.length;
+    return writer.buffer;
+}
+
+int json_dump_to_fixed(json_node_t node, int indent, char* buffer, jsize_t size, jsize_t* length) {
+    struct json_writer writer;
+    errno = 0;
+    if (!node || (indent < 0) || !buffer || (size == 0U)) {
+        errno = EINVAL;  /* FIXME: error code */
+        return (-1);
+    }
+    (void)memset(&writer, 0, sizeof(struct json_writer));
+    writer.indent = indent;
+    writer.buffer = buffer;
+    writer.size = (size_t)size - 1U;
+    dump_value(node, (-1), &writer);
+    writer.buffer[writer.length] = '\0';
+    if (length)
+        *length = (jsize_t)writer.total;
+    if (!writer.error && (writer.total > writer.length))
+        writer.error = ERANGE;
+    errno = writer.error;
+    return writer.error ? (-1) : 0;
+}
+
+int json_dump_cb(json_node_t node, int indent, json_write_t write, void* context) {
+    errno = 0;
+    if (!node || (indent < 0) || !write) {
+        errno = EINVAL;  /* FIXME: error code */
+        return (-1);
+    }
+    return dump_stream(node, indent, write, context);
+}
+
+/*  -----------  local functions  ----------------------------------------
+ */
+static int file_size(FILE* fp, size_t* size) {
+    assert(fp);
+    assert(size);
+#if defined(_WIN32)
+    {   /* 64-bit file offsets on LLP64 */
+        __int64 len;
+        if (_fseeki64(fp, 0, SEEK_END) != 0)
+            return (-1);
+        if ((len = _ftelli64(fp)) < 0)
+            return (-1);
+        if (_fseeki64(fp, 0, SEEK_SET) != 0)
+            return (-1);
+        if ((unsigned __int64)len >= (unsigned __int64)((size_t)-1)) {
+            errno = EFBIG;
+            return (-1);
+        }
+        *size = (size_t)len;
+    }
+#else
+    {   /* 64-bit file offsets with _FILE_OFFSET_BITS=64 */
+        off_t len;
+        if (fseeko(fp, 0, SEEK_END) != 0)
+            return (-1);
+        if ((len = ftello(fp)) < 0)
+            return (-1);
+        if (fseeko(fp, 0, SEEK_SET) != 0)
+            return (-1);
+        if (((off_t)(size_t)len != len) || ((size_t)len == (size_t)-1)) {
+            errno = EFBIG;
+            return (-1);
+        }
+        *size = (size_t)len;
+    }
+#endif
+    return 0;
+}
+
+static char* load_file(const char* filename, size_t* length) {
+    char* buffer = NULL;
+    FILE* fp = NULL;
+    assert(filename);
+    assert(length);
+    /* (1) open the file */
+    if ((fp = fopen(filename, "rb")) == NULL) {
+        /* errno set */
+        return NULL;
+    }
+    /* (2) determine its size */
+    if (file_size(fp, length) < 0) {
+        /* errno set */
+        (void)fclose(fp);
+        return NULL;
+    }
+    /* (3) read its content into a buffer */
+    if ((buffer = (char*)malloc(*length + (size_t)1)) == NULL) {
+        /* errno set */
+        (void)fclose(fp);
+        return NULL;
+    }
+    if (fread(buffer, sizeof(char), *length, fp) != *length) {
+        /* errno set */
+        free(buffer);
+        (void)fclose(fp);
+        return NULL;
+    }
+    /* (4) close it again */
+    if (fclose(fp) != 0) {
+        /* errno set */
+        free(buffer);
+        return NULL;
+    }
+    buffer[*length] = '\0';
+    return buffer;
+}
+
+#if (MMAP_SUPPORTED != 0)
+static char* map_file(const char* filename, size_t* length, int writable) {
+    void* addr = NULL;
+    struct stat st;
+    int fd = (-1);
+    assert(filename);
+    assert(length);
+    /* (1) open the file */
+    if ((fd = open(filename, O_RDONLY)) < 0) {
+        /* errno set */
+        return NULL;
+    }
+    /* (2) determine its size (only regular files can be mapped) */
+    if ((fstat(fd, &st) != 0) || !S_ISREG(st.st_mode) || (st.st_size <= 0) ||
+        ((off_t)(size_t)st.st_size != st.st_size)) {
+        (void)close(fd);
+        return NULL;
+    }
+    /* (3) map its content into memory (no trailing zero, private copy-on-write) */
+    addr = mmap(NULL, (size_t)st.st_size, writable ? (PROT_READ | PROT_WRITE) : PROT_READ, MAP_PRIVATE, fd, 0);
+    (void)close(fd);
+    if (addr == MAP_FAILED) {
+        /* errno set */
+        return NULL;
+    }
+    /* (4) the parser reads the mapping once from start to end */
+    (void)posix_madvise(addr, (size_t)st.st_size, POSIX_MADV_SEQUENTIAL);
+    *length = (size_t)st.st_size;
+    return (char*)addr;
+}
+
+static void unmap_file(char* buffer, size_t length) {
+    if (buffer)
+        (void)munmap((void*)buffer, length);
+}
+#endif
+
+static void free_source(char* buffer, size_t length, int owner) {
+    int error = errno;
+    switch (owner) {
+    case SOURCE_ALLOCATED: free(buffer); break;
+#if (MMAP_SUPPORTED != 0)
+    case SOURCE_MAPPED: unmap_file(buffer, length); break;
+#endif
+    default: break;
+    }
+    (void)length;
+    errno = error;
+}
+
+static json_node_t parse_buffer(const char* buffer, size_t length, unsigned int options) {
+    struct json_document* doc = NULL;
+    json_node_t root = NULL;
+    json_file_t file;
+    int error;
+    assert(buffer);
+    if (length == 0) {
+        set_last_error(JSON_ERR_END, buffer, 0);
+        return NULL;
+    }
+    /* the document owns the arena from which the tree is allocated */
+    if ((doc = (struct json_document*)malloc(sizeof(struct json_document))) == NULL) {
+        /* errno set */
+        set_last_error(JSON_ERR_MEMORY, NULL, 0);
+        return NULL;
+    }
+    arena_init(&doc->arena, length);
+    doc->magic = DOCUMENT_MAGIC;
+    doc->self = doc;
+    doc->source = NULL;
+    doc->length = 0;
+    doc->owner = SOURCE_BORROWED;
+    (void)memset(&file, 0, sizeof(json_file_t));
+    root = parse_tree(&file, doc, buffer, length, options);
+    error = errno;
+    free(file.stack);
+    free(file.frame);
+    if (root == NULL)
+        free_document(doc);
+    errno = error;
+    return root;
+}
+
+static json_node_t parse_tree(JSON json, struct json_document* doc, const char* buffer, size_t length, unsigned int options) {
+    json_node_t root = NULL;
+    int error;
+    assert(json);
+    assert(doc);
+    assert(buffer);
+    assert(length > 0);
+    init_kernels();
+    /* the lexer is bounded by the length, i.e. the buffer
+     * is neither copied nor must it be zero-terminated */
+    json->buf = buffer;
+    json->len = length;
+    json->arena = &doc->arena;
+    /* in-situ: strings are zero-terminated in the buffer (the caller
+     * ensures it is writable and outlives the document) */
+    json->insitu = (options & JSON_OPT_INSITU) ? (char*)buffer : NULL;
+    json->options = options;
+#if (THREADS_SUPPORTED != 0)
+    /* a large top-level array is parsed in slices by several threads
+     * (if that fails, e.g. on a syntax error, it is parsed as usual) */
+    if ((options & JSON_OPT_PARALLEL) && (length >= (size_t)JSON_PARALLEL_THRESHOLD))
+        root = parse_parallel(json, (JSON_PARALLEL_THREADS > 0) ? JSON_PARALLEL_THREADS : count_processors());
+#endif
+    if (root == NULL)
+        root = parse_value(json);
+    error = errno;
+    if (root == NULL) {
+        /* errno set */
+        if (json->error == JSON_ERR_NONE) {
+            /* not a syntax error */
+            json->error = (error == ENOMEM) ? JSON_ERR_MEMORY : JSON_ERR_LIMIT;
+            json->fail = json->pos;
+        }
+        set_last_error(json->error, buffer, json->fail);
+        errno = error;
+        return NULL;
+    }
+    set_last_error(JSON_ERR_NONE, NULL, 0);
+    errno = error;
+    /* the root node is embedded into the document */
+    doc->root = *root;
+    return &doc->root;
+}
+
+static json_node_t keep_source(json_node_t root, char* buffer, size_t length, int owner) {
+    struct json_document* doc = DOCUMENT(root);
+    assert(root);
+    doc->source = buffer;
+    doc->length = length;
+    doc->owner = owner;
+    return root;
+}
+
+static int parse_stream(JSON json, const char* buffer, size_t length, const json_handler_t* handler, void* context) {
+    int rc, error;
+    assert(json);
+    assert(buffer);
+    assert(handler);
+    if (length == 0) {
+        set_last_error(JSON_ERR_END, buffer, 0);
+        return (-1);
+    }
+    init_kernels();
+    (void)memset(json, 0, sizeof(json_file_t));
+    /* no tree, no arena: only the parser stack is needed */
+    json->buf = buffer;
+    json->len = length;
+    json->final = 1;
+    rc = parse_events(json, handler, context);
+    error = errno;
+    free(json->frame);
+    json->frame = NULL;
+    if ((rc == 1) && (json->error != JSON_ERR_NONE)) {
+        /* an internal handler failed (not stopped) */
+        rc = (-1);
+    }
+    if (rc < 0) {
+        /* errno set */
+        if (json->error == JSON_ERR_NONE) {
+            /* not a syntax error */
+            json->error = (error == ENOMEM) ? JSON_ERR_MEMORY : JSON_ERR_LIMIT;
+            json->fail = json->pos;
+        }
+        set_last_error(json->error, buffer, json->fail);
+    } else {
+        set_last_error(JSON_ERR_NONE, NULL, 0);
+    }
+    errno = error;
+    return rc;
+}
+
+static void parse_error(JSON json, int reason) {
+    assert(json);
+    /* the innermost error is reported, the parser just unwinds */
+    if (json->error == JSON_ERR_NONE) {
+        json->error = (json->pos < json->len) ? reason : JSON_ERR_END;
+        json->fail = json->pos;
+    }
+    errno = EINVAL;
+}
+
+static void set_last_error(int reason, const char* buffer, size_t offset) {
+    long line = 1, column = 1;
+    /* line and column are computed from the offset on error only */
+    if (buffer && (reason != JSON_ERR_NONE))
+        count_lines(buffer, offset, &line, &column);
+    last_error.reason = reason;
+    last_error.offset = (jsize_t)offset;
+    last_error.line = ((reason != JSON_ERR_NONE) && buffer) ? line : 0;
+    last_error.column = ((reason != JSON_ERR_NONE) && buffer) ? column : 0;
+    last_error.message = error_messages[reason];
+}
+
+static void count_lines(const char* buffer, size_t length, long* line, long* column) {
+    size_t i;
+    assert(line);
+    assert(column);
+    for (i = 0; buffer && (i < length); i++) {
+        if (buffer[i] == '\n') {
+            *column = 1;
+            (*line)++;
+        } else if (buffer[i] == '\t') {
+            *column = (((*column - 1) / TAB_SIZE) + 1) * TAB_SIZE + 1;
+        } else {
+            (*column)++;
+        }
+    }
+}
+
+static void free_document(struct json_document* doc) {
+    if (doc) {
+        arena_free(&doc->arena);
+        free_source(doc->source, doc->length, doc->owner);
+        free(doc);
+    }
+}
+
+static int push_value(JSON json, json_node_t value) {
+    struct json_node** stack = NULL;
+    size_t size;
+    assert(json);
+    if (json->top == json->size) {
+        size = (json->size > 0) ? (json->size * 2U) : STACK_SIZE_MIN;
+        if ((size < json->size) || (size > ((size_t)-1 / sizeof(struct json_node*)))) {
+            errno = ENOMEM;
+            return (-1);
+        }
+        if ((stack = (struct json_node**)realloc(json->stack, size * sizeof(struct json_node*))) == NULL) {
+            /* errno set */
+            return (-1);
+        }
+        json->stack = stack;
+        json->size = size;
+    }
+    json->stack[json->top++] = value;
+    return 0;
+}
+
+/*  hash index: open addressing with linear probing, at most half of the slots
+ *  are used. The members remain in their linked list (insertion order), the
+ *  index only points to them. Of duplicate keys only the first is indexed.
+ */
+static int make_index(JSON json, json_node_t node, size_t count) {
+    struct json_index* index = NULL;
+    struct json_member* curr = NULL;
+    struct json_member** slot = NULL;
+    unsigned long size = 1UL;
+    unsigned long i;
+    assert(json);
+    assert(node);
+    while ((size / 2UL) < (unsigned long)count) {
+        if ((size *= 2UL) == 0UL) {
+            errno = ENOMEM;
+            return (-1);
+        }
+    }
+    if ((index = (struct json_index*)arena_alloc(json->arena, sizeof(struct json_index))) == NULL) {
+        /* errno set */
+        return (-1);
+    }
+    if ((slot = (struct json_member**)arena_alloc(json->arena, (size_t)size * sizeof(struct json_member*))) == NULL) {
+        /* errno set */
+        return (-1);
+    }
+    (void)memset(slot, 0, (size_t)size * sizeof(struct json_member*));
+    index->mask = size - 1UL;
+    index->slot = slot;
+    for (curr = node->value.dict.head; curr; curr = curr->next) {
+        i = hash_string(curr->string) & index->mask;
+        while (slot[i] && strcmp(slot[i]->string, curr->string))
+            i = (i + 1UL) & index->mask;
+        if (!slot[i])
+            slot[i] = curr;
+    }
+    node->value.dict.index = index;
+    return 0;
+}
+
+static struct json_member* find_member(const struct json_node* node, const char* string) {
+    assert(node);
+    assert(string);
+    return find_hashed(node, string, node->value.dict.index ? hash_string(string) : 0UL);
+}
+
+static struct json_member* find_hashed(const struct json_node* node, const char* string, unsigned long hash) {
+    struct json_index* index = NULL;
+    struct json_member* curr = NULL;
+    unsigned long i;
+    assert(node);
+    assert(string);
+    if ((index = node->value.dict.index) != NULL) {
+        /* hashed lookup */
+        i = hash & index->mask;
+        while ((curr = index->slot[i]) != NULL) {
+            if (!strcmp(curr->string, string))
+                break;
+            i = (i + 1UL) & index->mask;
+        }
+    } else {
+        /* linear search */
+        curr = node->value.dict.head;
+        while ((curr != NULL) && (curr->string != NULL) && (strcmp(curr->string, string)))
+            curr = curr->next;
+    }
+    return curr;
+}
+
+static unsigned long hash_string(const char* string) {
+    unsigned long hash = 2166136261UL;  /* FNV-1a */
+    assert(string);
+    while (*string) {
+        hash ^= (unsigned long)(unsigned char)*string++;
+        hash *= 16777619UL;
+    }
+    return hash;
+}
+
+static json_node_t new_node(JSON json, json_type_t type) {
+    struct json_node* node = NULL;
+    assert(json);
+    if ((node = (struct json_node*)arena_alloc(json->arena, sizeof(struct json_node))) != NULL)
+        node->type = type;
+    return node;
+}
+
+/*  bump allocator: nodes, members, elements and strings are carved out of
+ *  large chunks, the whole tree is released at once (chunk by chunk). The
+ *  first chunk is sized from the input length, the following ones double.
+ */
+static void arena_init(struct json_arena* arena, size_t length) {
+    assert(arena);
+    arena->head = NULL;
+    if (length < (CHUNK_SIZE_MAX / 2U))
+        arena->grow = ALIGN(length * 2U);
+    else
+        arena->grow = CHUNK_SIZE_MAX;
+    if (arena->grow < CHUNK_SIZE_MIN)
+        arena->grow = CHUNK_SIZE_MIN;
+}
+
+static void* arena_alloc(struct json_arena* arena, size_t size) {
+    struct json_chunk* chunk = NULL;
+    size_t offset;
+    assert(arena);
+    /* fast path: bump the offset in the current chunk */
+    if ((chunk = arena->head) != NULL) {
+        offset = ALIGN(chunk->used);
+        if ((offset <= chunk->size) && (size <= (chunk->size - offset))) {
+            chunk->used = offset + size;
+            return (void*)((char*)chunk + CHUNK_HEADER + offset);
+        }
+    }
+    /* slow path: get a new chunk (oversized requests get their own) */
+    if (size >= ((size_t)-1 - CHUNK_HEADER)) {
+        errno = ENOMEM;
+        return NULL;
+    }
+    if ((chunk = (struct json_chunk*)malloc(CHUNK_HEADER + ((size > arena->grow) ? size : arena->grow))) == NULL) {
+        /* errno set */
+        return NULL;
+    }
+    chunk->size = (size > arena->grow) ? size : arena->grow;
+    chunk->used = size;
+    if ((size > arena->grow) && (arena->head != NULL)) {
+        chunk->next = arena->head->next;
+        arena->head->next = chunk;
+    } else {
+        chunk->next = arena->head;
+        arena->head = chunk;
+        if (arena->grow < CHUNK_SIZE_MAX)
+            arena->grow *= 2U;
+    }
+    return (void*)((char*)chunk + CHUNK_HEADER);
+}
+
+static char* arena_strndup(struct json_arena* arena, const char* string, size_t length) {
+    struct json_chunk* chunk = NULL;
+    char* copy = NULL;
+    assert(arena);
+    assert(string);
+    /* strings need no alignment */
+    if (((chunk = arena->head) != NULL) && (length < (chunk->size - chunk->used))) {
+        copy = (char*)chunk + CHUNK_HEADER + chunk->used;
+        chunk->used += length + 1U;
+    } else if ((copy = (char*)arena_alloc(arena, length + 1U)) == NULL) {
+        /* errno set */
+        return NULL;
+    }
+    (void)memcpy(copy, string, length);
+    copy[length] = '\0';
+    return copy;
+}
+
+static void arena_reset(struct json_arena* arena) {
+    struct json_chunk* chunk = NULL;
+    size_t size = 0U;
+    int error = errno;
+    assert(arena);
+    /* the chunks are merged into one chunk with the capacity of all of
+     * them, i.e. a document of the same size is allocated without malloc */
+    if (((chunk = arena->head) != NULL) && (chunk->next == NULL)) {
+        chunk->used = 0U;
+        return;
+    }
+    for (chunk = arena->head; chunk; chunk = chunk->next)
+        size += chunk->size;
+    arena_free(arena);
+    if ((size > 0U) && ((chunk = (struct json_chunk*)malloc(CHUNK_HEADER + size)) != NULL)) {
+        chunk->next = NULL;
+        chunk->size = size;
+        chunk->used = 0U;
+        arena->head = chunk;
+    }
+    errno = error;
+}
+
+static void arena_free(struct json_arena* arena) {
+    struct json_chunk* chunk = NULL;
+    assert(arena);
+    while ((chunk = arena->head) != NULL) {
+        arena->head = chunk->next;
+        free(chunk);
+    }
+}
+
+static char get_char(JSON json) {
+    assert(json);
+    assert(json->buf);
+    assert(json->len >= 1);
+    assert(json->pos <= json->len);
+    /* note: line and column are not tracked (they can be
+     *       derived from the position, if needed) */
+    if (json->pos < json->len) {
+        return json->buf[json->pos++];
+    }
+    return 0;
+}
+/*  <whitespace> : ' ' | '\n' | '\r' | '\t'
+ *               ;
+ */
+static char lookahead(JSON json) {
+    assert(json);
+    assert(json->buf);
+    assert(json->len >= 1);
+    assert(json->pos <= json->len);
+    /* short runs (e.g. minified text) are skipped inline */
+    if ((json->pos < json->len) && IS_WHITESPACE(json->buf[json->pos])) {
+        json->pos++;
+        if ((json->pos < json->len) && IS_WHITESPACE(json->buf[json->pos]))
+            json->pos = skip_whitespace(json->buf, json->pos, json->len);
+    }
+    return (json->pos < json->len) ? json->buf[json->pos] : '\0';
+}
+
+/*  whitespace kernels: return the position of the first non-whitespace
+ *  character at or after 'pos' (or 'len'). Runs of whitespace (e.g. the
+ *  indentation of pretty-printed text) are skipped 32 (AVX2), 16 (SSE2) or
+ *  sizeof(size_t) (SWAR) bytes at once. They never read beyond 'len'.
+ */
+static size_t skip_scalar(const char* buf, size_t pos, size_t len) {
+    while ((pos < len) && IS_WHITESPACE(buf[pos]))
+        pos++;
+    return pos;
+}
+
+#if (SIMD_SSE2 == 0)
+static size_t skip_swar(const char* buf, size_t pos, size_t len) {
+    const size_t ones = (size_t)-1 / 255U;     /* 0x0101...01 */
+    const size_t low7 = ones * 0x7FU;          /* 0x7F7F...7F */
+    size_t word, space;
+    while ((pos + sizeof(size_t)) <= len) {
+        (void)memcpy(&word, &buf[pos], sizeof(size_t));
+        /* high bit of each byte is set, if the byte is a whitespace */
+        space = SWAR_EQUAL(word, ones * (size_t)' ', low7)
+              | SWAR_EQUAL(word, ones * (size_t)'\n', low7)
+              | SWAR_EQUAL(word, ones * (size_t)'\r', low7)
+              | SWAR_EQUAL(word, ones * (size_t)'\t', low7);
+        if (space != (ones * 0x80U))
+            break;  /* the first non-whitespace is in this word */
+        pos += sizeof(size_t);
+    }
+    return skip_scalar(buf, pos, len);
+}
+#endif
+
+#if (SIMD_SSE2 != 0)
+static size_t skip_sse2(const char* buf, size_t pos, size_t len) {
+    const __m128i sp = _mm_set1_epi8(' ');
+    const __m128i lf = _mm_set1_epi8('\n');
+    const __m128i cr = _mm_set1_epi8('\r');
+    const __m128i ht = _mm_set1_epi8('\t');
+    __m128i data, space;
+    unsigned int mask;
+    while ((pos + 16U) <= len) {
+        data = _mm_loadu_si128((const __m128i*)&buf[pos]);
+        space = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(data, sp), _mm_cmpeq_epi8(data, lf)),
+                             _mm_or_si128(_mm_cmpeq_epi8(data, cr), _mm_cmpeq_epi8(data, ht)));
+        if ((mask = (unsigned int)_mm_movemask_epi8(space) ^ 0xFFFFU) != 0U)
+            return pos + first_bit(mask);
+        pos += 16U;
+    }
+    return skip_scalar(buf, pos, len);
+}
+#endif
+
+#if (SIMD_AVX2 != 0)
+TARGET_AVX2 static size_t skip_avx2(const char* buf, size_t pos, size_t len) {
+    const __m256i sp = _mm256_set1_epi8(' ');
+    const __m256i lf = _mm256_set1_epi8('\n');
+    const __m256i cr = _mm256_set1_epi8('\r');
+    const __m256i ht = _mm256_set1_epi8('\t');
+    __m256i data, space;
+    unsigned int mask;
+    while ((pos + 32U) <= len) {
+        data = _mm256_loadu_si256((const __m256i*)&buf[pos]);
+        space = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(data, sp), _mm256_cmpeq_epi8(data, lf)),
+                                _mm256_or_si256(_mm256_cmpeq_epi8(data, cr), _mm256_cmpeq_epi8(data, ht)));
+        if ((mask = ~(unsigned int)_mm256_movemask_epi8(space)) != 0U)
+            return pos + first_bit(mask);
+        pos += 32U;
+    }
+    return skip_sse2(buf, pos, len);
+}
+#endif
+
+/*  string kernels: return the position of the first quote, backslash or
+ *  control character at or after 'pos' (or 'len'). Everything before it
+ *  belongs to the string as is. They never read beyond 'len'.
+ */
+static size_t find_scalar(const char* buf, size_t pos, size_t len) {
+    while ((pos < len) && !IS_SPECIAL(buf[pos]))
+        pos++;
+    return pos;
+}
+
+#if (SIMD_SSE2 == 0)
+static size_t find_swar(const char* buf, size_t pos, size_t len) {
+    const size_t ones = (size_t)-1 / 255U;     /* 0x0101...01 */
+    const size_t low7 = ones * 0x7FU;          /* 0x7F7F...7F */
+    size_t word, special;
+    while ((pos + sizeof(size_t)) <= len) {
+        (void)memcpy(&word, &buf[pos], sizeof(size_t));
+        /* high bit of each byte is set, if the byte is special */
+        special = SWAR_EQUAL(word, ones * (size_t)'"', low7)
+                | SWAR_EQUAL(word, ones * (size_t)'\\', low7)
+                | SWAR_LESS(word, 0x20U, low7);
+        if (special != 0U)
+            break;  /* the first special character is in this word */
+        pos += sizeof(size_t);
+    }
+    return find_scalar(buf, pos, len);
+}
+#endif
+
+#if (SIMD_SSE2 != 0)
+static size_t find_sse2(const char* buf, size_t pos, size_t len) {
+    const __m128i qt = _mm_set1_epi8('"');
+    const __m128i bs = _mm_set1_epi8('\\');
+    const __m128i us = _mm_set1_epi8(0x1F);
+    __m128i data, special;
+    unsigned int mask;
+    while ((pos + 16U) <= len) {
+        data = _mm_loadu_si128((const __m128i*)&buf[pos]);
+        /* note: max(c, 0x1F) == 0x1F for control characters only */
+        special = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(data, qt), _mm_cmpeq_epi8(data, bs)),
+                               _mm_cmpeq_epi8(_mm_max_epu8(data, us), us));
+        if ((mask = (unsigned int)_mm_movemask_epi8(special)) != 0U)
+            return pos + first_bit(mask);
+        pos += 16U;
+    }
+    return find_scalar(buf, pos, len);
+}
+#endif
+
+#if (SIMD_AVX2 != 0)
+TARGET_AVX2 static size_t find_avx2(const char* buf, size_t pos, size_t len) {
+    const __m256i qt = _mm256_set1_epi8('"');
+    const __m256i bs = _mm256_set1_epi8('\\');
+    const __m256i us = _mm256_set1_epi8(0x1F);
+    __m256i data, special;
+    unsigned int mask;
+    while ((pos + 64U) <= len) {
+        /* two blocks per iteration for long strings */
+        data = _mm256_loadu_si256((const __m256i*)&buf[pos]);
+        special = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(data, qt), _mm256_cmpeq_epi8(data, bs)),
+                                  _mm256_cmpeq_epi8(_mm256_max_epu8(data, us), us));
+        if ((mask = (unsigned int)_mm256_movemask_epi8(special)) != 0U)
+            return pos + first_bit(mask);
+        data = _mm256_loadu_si256((const __m256i*)&buf[pos + 32U]);
+        special = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(data, qt), _mm256_cmpeq_epi8(data, bs)),
+                                  _mm256_cmpeq_epi8(_mm256_max_epu8(data, us), us));
+        if ((mask = (unsigned int)_mm256_movemask_epi8(special)) != 0U)
+            return pos + 32U + first_bit(mask);
+        pos += 64U;
+    }
+    return find_sse2(buf, pos, len);
+}
+#endif
+
+/*  the kernels are selected once per process (AVX2 at run-time), before
+ *  the first text is parsed, i.e. the function pointers are not written
+ *  while other threads parse
+ */
+static void init_kernels(void) {
+#if (SIMD_AVX2 != 0)
+#if (THREADS_SUPPORTED != 0)
+    static pthread_once_t once = PTHREAD_ONCE_INIT;
+    (void)pthread_once(&once, select_kernels);
+#else
+    static INIT_ONCE once = INIT_ONCE_STATIC_INIT;
+    (void)InitOnceExecuteOnce(&once, select_once, NULL, NULL);
+#endif
+#endif
+}
+
+#if (SIMD_AVX2 != 0)
+static void select_kernels(void) {
+    if (cpu_has_avx2()) {
+        skip_whitespace = skip_avx2;
+        find_special = find_avx2;
+    } else {
+        skip_whitespace = skip_sse2;
+        find_special = find_sse2;
+    }
+}
+#if (THREADS_SUPPORTED == 0)
+
+static BOOL CALLBACK select_once(PINIT_ONCE once, PVOID parameter, PVOID* context) {
+    (void)once;
+    (void)parameter;
+    (void)context;
+    select_kernels();
+    return TRUE;
+}
+#endif
+#endif
+
+#if (SIMD_SSE2 != 0)
+static unsigned int first_bit(unsigned int mask) {
+#if defined(_MSC_VER)
+    unsigned long index;
+    (void)_BitScanForward(&index, (unsigned long)mask);
+    return (unsigned int)index;
+#else
+    return (unsigned int)__builtin_ctz(mask);
+#endif
+}
+#endif
+
+#if (SIMD_AVX2 != 0)
+static int cpu_has_avx2(void) {
+#if defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 1);
+    /* OSXSAVE and AVX, and the OS saves the YMM registers */
+    if (!(info[2] & (1 << 27)) || !(info[2] & (1 << 28)) || ((_xgetbv(0) & 6U) != 6U))
+        return 0;
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) ? 1 : 0;
+#else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2") ? 1 : 0;
+#endif
+}
+#endif
+/*  <value>      : <object>
+ *               | <array>
+ *               | <string>
+ *               | <number>
+ *               | "true"
+ *               | "false"
+ *               | "null"
+ *               ;
+ */
+static json_node_t parse_value(JSON json) {
+    struct json_frame* frame = NULL;
+    struct json_node* value = NULL;
+    assert(json);
+    /* note: the parser does not recurse, open objects and arrays are kept
+     *       on the parser stack (on the heap) and its depth is limited */
+    for (;;) {
+        /* (1) a scalar value, or the beginning of an object or an array */
+        switch (lookahead(json)) {
+        case '{':
+            if (open_object(json) == NULL) {
+                /* errno set */
+                return NULL;
+            }
+            if (lookahead(json) != '}') {
+                /* continue with the value of the first member */
+                if (next_member(json) < 0) {
+                    /* errno set */
+                    return NULL;
+                }
+                continue;
+            }
+            (void)get_char(json);
+            value = close_object(json, &json->frame[--json->depth]);
+            break;
+        case '[':
+            if (open_array(json) == NULL) {
+                /* errno set */
                 return NULL;
             }
-            /* get member value (as JSON value) */
-            value = parse_value(json);
-            if (value == NULL) {
+            if (lookahead(json) != ']') {
+                /* continue with the first element */
+                continue;
+            }
+            (void)get_char(json);
+            value = close_array(json, &json->frame[--json->depth]);
+            break;
+        case '"':
+            value = parse_string(json);
+            break;
+        case '-':
+        case '0': case '1': case '2':  case '3': case '4':
+        case '5': case '6': case '7':  case '8': case '9':
+            value = parse_number(json);
+            break;
+        case 't':
+            value = parse_literal(json, JSON_TRUE);
+            break;
+        case 'f':
+            value = parse_literal(json, JSON_FALSE);
+            break;
+        case 'n':
+            value = parse_literal(json, JSON_NULL);
+            break;
+        default:
+            parse_error(json, JSON_ERR_SYNTAX);
+            return NULL;
+        }
+        /* (2) the value goes into the innermost object or array, which
+         *     is closed when its last value was parsed (and so on) */
+        while (value != NULL) {
+            if (json->depth == json->root) {
+                /* the root value (or an element of a slice) */
+                return value;
+            }
+            frame = &json->frame[json->depth - 1];
+            if (frame->type == JSON_OBJECT) {
+                frame->last->value = value;
+                if (lookahead(json) == ',') {
+                    (void)get_char(json);
+                    if (next_member(json) < 0) {
+                        /* errno set */
+                        return NULL;
+                    }
+                    break;
+                }
+                if (lookahead(json) != '}') {
+                    parse_error(json, JSON_ERR_SYNTAX);
+                    return NULL;
+                }
+                (void)get_char(json);
+                value = close_object(json, &json->frame[--json->depth]);
+            } else {
+                if (push_value(json, value) < 0) {
+                    /* errno set */
+                    return NULL;
+                }
+                if (lookahead(json) == ',') {
+                    (void)get_char(json);
+                    break;
+                }
+                if (lookahead(json) != ']') {
+                    parse_error(json, JSON_ERR_SYNTAX);
+                    return NULL;
+                }
+                (void)get_char(json);
+                value = close_array(json, &json->frame[--json->depth]);
+            }
+        }
+        if (value == NULL) {
+            /* errno set */
+            return NULL;
+        }
+    }
+}
+
+static int push_frame(JSON json, json_type_t type, json_node_t node) {
+    struct json_frame* frame = NULL;
+    size_t levels;
+    assert(json);
+    if ((JSON_MAX_DEPTH > 0) && (json->depth >= (size_t)JSON_MAX_DEPTH)) {
+        parse_error(json, JSON_ERR_DEPTH);
+        return (-1);
+    }
+    if (json->depth == json->levels) {
+        levels = (json->levels > 0) ? (json->levels * 2U) : FRAME_SIZE_MIN;
+        if ((levels < json->levels) || (levels > ((size_t)-1 / sizeof(struct json_frame)))) {
+            errno = ENOMEM;
+            return (-1);
+        }
+        if ((frame = (struct json_frame*)realloc(json->frame, levels * sizeof(struct json_frame))) == NULL) {
+            /* errno set */
+            return (-1);
+        }
+        json->frame = frame;
+        json->levels = levels;
+    }
+    frame = &json->frame[json->depth++];
+    frame->type = type;
+    frame->node = node;
+    frame->last = NULL;
+    frame->base = json->top;
+    frame->count = 0;
+    return 0;
+}
+
+/*  event parser: the same grammar as parse_value(), but the values are passed
+ *  to the callbacks of the handler instead of building a tree. Only the open
+ *  objects and arrays are kept on the parser stack (without nodes).
+ *  The parser is a state machine that can be suspended between two tokens,
+ *  if the text is not final (push parser). Then an incomplete token at the
+ *  end of the buffer is left unread (from 'pos' on) and parsing is resumed
+ *  with the rest of the token in the next buffer.
+ *  Returns 0 at the end of the root value, 1 if stopped by a callback,
+ *  2 if suspended, or -1 on error.
+ */
+#define EMIT(cb,args)  do { if ((cb) && ((cb) args != 0)) return 1; } while(0)
+
+static int parse_events(JSON json, const json_handler_t* handler, void* context) {
+    struct json_frame* frame = NULL;
+    struct json_node* literal = NULL;
+    const char* string = NULL;
+    size_t start, length = 0;
+    int rc;
+    char ch;
+    assert(json);
+    assert(handler);
+    for (;;) {
+        if ((json->state == STATE_NEXT) && (json->depth == 0))
+            json->state = STATE_DONE;
+        if (json->state == STATE_DONE) {
+            /* end of the root value */
+            return 0;
+        }
+        ch = lookahead(json);
+        if ((json->pos >= json->len) && !json->final) {
+            /* wait for more text */
+            return PARSE_SUSPENDED;
+        }
+        switch (json->state) {
+        case STATE_FIRST_MEMBER:
+            /* an object: '}' or the first member */
+            if (ch == '}') {
+                (void)get_char(json);
+                json->depth--;
+                json->state = STATE_NEXT;
+                EMIT(handler->end_object, (context));
+                break;
+            }
+            /* fall through */
+        case STATE_MEMBER:
+            /* a member: the key (':' and the value follow) */
+            if ((rc = next_key(json, handler, context)) != 0)
+                return rc;
+            break;
+        case STATE_COLON:
+            /* the ':' after the key (whitespace before it is skipped,
+             * i.e. it is never carried over to the next buffer) */
+            if (ch != ':') {
+                parse_error(json, JSON_ERR_SYNTAX);
+                return (-1);
+            }
+            (void)get_char(json);
+            json->state = STATE_VALUE;
+            break;
+        case STATE_FIRST_ELEMENT:
+            /* an array: ']' or the first element */
+            if (ch == ']') {
+                (void)get_char(json);
+                json->depth--;
+                json->state = STATE_NEXT;
+                EMIT(handler->end_array, (context));
+                break;
+            }
+            /* fall through */
+        case STATE_VALUE:
+            /* a scalar value, or the beginning of an object or an array */
+            switch (ch) {
+            case '{':
+                if (push_frame(json, JSON_OBJECT, NULL) < 0) {
+                    /* errno set */
+                    return (-1);
+                }
+                (void)get_char(json);
+                json->state = STATE_FIRST_MEMBER;
+                EMIT(handler->start_object, (context));
+                break;
+            case '[':
+                if (push_frame(json, JSON_ARRAY, NULL) < 0) {
+                    /* errno set */
+                    return (-1);
+                }
+                (void)get_char(json);
+                json->state = STATE_FIRST_ELEMENT;
+                EMIT(handler->start_array, (context));
+                break;
+            case '"':
+                start = json->pos;
+                if ((string = match_string(json, &length)) == NULL) {
+                    /* errno set */
+                    return suspend(json, start);
+                }
+                json->state = STATE_NEXT;
+                EMIT(handler->string, (context, string, (jsize_t)length));
+                break;
+            case '-':
+            case '0': case '1': case '2':  case '3': case '4':
+            case '5': case '6': case '7':  case '8': case '9':
+                if (!json->final && (skip_token(json->buf, json->pos, json->len, NUMBER_CHARS) == json->len)) {
+                    /* the number may go on in the next buffer */
+                    return PARSE_SUSPENDED;
+                }
+                if ((length = scan_number(json)) == 0) {
+                    parse_error(json, JSON_ERR_NUMBER);
+                    return (-1);
+                }
+                string = &json->buf[json->pos];
+                json->pos += length;
+                json->state = STATE_NEXT;
+                EMIT(handler->number, (context, string, (jsize_t)length));
+                break;
+            case 't':
+            case 'f':
+            case 'n':
+                if (!json->final && (skip_token(json->buf, json->pos, json->len, LITERAL_CHARS) == json->len)) {
+                    /* the literal may go on in the next buffer */
+                    return PARSE_SUSPENDED;
+                }
+                /* note: literals are shared nodes, they take no memory */
+                if ((literal = parse_literal(json, (ch == 't') ? JSON_TRUE : (ch == 'f') ? JSON_FALSE : JSON_NULL)) == NULL) {
+                    /* errno set */
+                    return (-1);
+                }
+                json->state = STATE_NEXT;
+                EMIT(handler->literal, (context, literal->type));
+                break;
+            default:
+                parse_error(json, JSON_ERR_SYNTAX);
+                return (-1);
+            }
+            break;
+        case STATE_NEXT:
+            /* the innermost object or array ends, or another member or element follows */
+            frame = &json->frame[json->depth - 1];
+            if (ch == ',') {
+                (void)get_char(json);
+                json->state = (frame->type == JSON_OBJECT) ? STATE_MEMBER : STATE_VALUE;
+                break;
+            }
+            if (ch != ((frame->type == JSON_OBJECT) ? '}' : ']')) {
+                parse_error(json, JSON_ERR_SYNTAX);
+                return (-1);
+            }
+            (void)get_char(json);
+            json->depth--;
+            if (frame->type == JSON_OBJECT)
+                EMIT(handler->end_object, (context));
+            else
+                EMIT(handler->end_array, (context));
+            break;
+        default:
+            parse_error(json, JSON_ERR_SYNTAX);
+            return (-1);
+        }
+    }
+}
+
+static int next_key(JSON json, const json_handler_t* handler, void* context) {
+    const char* string = NULL;
+    size_t start, length = 0;
+    assert(json);
+    assert(handler);
+    start = json->pos;
+    /* get member key (as string) */
+    if ((string = match_string(json, &length)) == NULL) {
+        /* errno set */
+        return suspend(json, start);
+    }
+    json->state = STATE_COLON;
+    EMIT(handler->key, (context, string, (jsize_t)length));
+    return 0;
+}
+#undef EMIT
+
+static int suspend(JSON json, size_t start) {
+    assert(json);
+    /* an error at the end of a buffer that is not final is none:
+     * the token is read again (from 'start') with the next buffer */
+    if (!json->final && (json->error == JSON_ERR_END)) {
+        json->error = JSON_ERR_NONE;
+        json->pos = start;
+        errno = 0;
+        return PARSE_SUSPENDED;
+    }
+    return (-1);
+}
+
+static size_t skip_token(const char* buf, size_t pos, size_t len, const char* chars) {
+    /* note: the token is checked by the parser, here only its end is found */
+    while ((pos < len) && (buf[pos] != '\0') && strchr(chars, buf[pos]))
+        pos++;
+    return pos;
+}
+
+/*  push parser: each chunk is run through the event parser until it is
+ *  suspended at its end. An incomplete token is carried over to the next
+ *  chunk, it is completed with the first bytes of that chunk and parsed
+ *  on its own. So, at most one token is buffered (not the whole text).
+ */
+static int feed_chunk(struct json_parser* parser, const char* chunk, size_t length) {
+    size_t idx = 0, take;
+    int done;
+    assert(parser);
+    while ((parser->carried > 0) && (idx < length)) {
+        /* (1) complete the incomplete token */
+        take = complete_token(parser, &chunk[idx], length - idx, &done);
+        if (append_carry(parser, &chunk[idx], take) < 0) {
+            /* errno set */
+            parser->status = (-1);
+            set_last_error(JSON_ERR_MEMORY, NULL, parser->offset);
+            return (-1);
+        }
+        idx += take;
+        if (!done)
+            return 0;
+        if (run_buffer(parser, parser->carry, parser->carried) != 0)
+            return parser->status;
+    }
+    /* (2) parse the rest of the chunk */
+    if ((idx < length) && (run_buffer(parser, &chunk[idx], length - idx) != 0))
+        return parser->status;
+    return 0;
+}
+
+static size_t complete_token(struct json_parser* parser, const char* chunk, size_t length, int* done) {
+    size_t idx = 0;
+    assert(parser);
+    assert(parser->carried > 0);
+    assert(done);
+    if (parser->carry[0] == '"') {
+        /* a string ends with the closing quote (or at a control character) */
+        idx = scan_escaped(chunk, 0, length, &parser->escape);
+    } else if (strchr(NUMBER_CHARS, parser->carry[0])) {
+        /* a number ends before the next character (which is needed, too) */
+        idx = skip_token(chunk, 0, length, NUMBER_CHARS);
+    } else {
+        /* a literal ends before the next character (which is needed, too) */
+        idx = skip_token(chunk, 0, length, LITERAL_CHARS);
+    }
+    *done = (idx < length) ? 1 : 0;
+    return (idx < length) ? (idx + 1U) : length;
+}
+
+static int run_buffer(struct json_parser* parser, const char* buffer, size_t length) {
+    JSON json = NULL;
+    size_t rest;
+    int rc, error;
+    assert(parser);
+    assert(buffer);
+    assert(length > 0);
+    json = &parser->file;
+    json->buf = buffer;
+    json->len = length;
+    json->pos = 0;
+    rc = parse_events(json, parser->handler, parser->context);
+    error = errno;
+    if ((rc == 1) && (json->error != JSON_ERR_NONE)) {
+        /* the tree builder failed (not stopped) */
+        rc = (-1);
+    }
+    if (rc < 0) {
+        /* errno set */
+        if (json->error == JSON_ERR_NONE) {
+            /* not a syntax error */
+            json->error = (error == ENOMEM) ? JSON_ERR_MEMORY : JSON_ERR_LIMIT;
+            json->fail = json->pos;
+        }
+        count_lines(buffer, json->fail, &parser->line, &parser->column);
+        set_last_error(json->error, NULL, parser->offset + json->fail);
+        last_error.line = parser->line;
+        last_error.column = parser->column;
+        parser->status = (-1);
+        errno = error;
+        return (-1);
+    }
+    /* the text up to the position is done with */
+    count_lines(buffer, json->pos, &parser->line, &parser->column);
+    parser->offset += json->pos;
+    if (rc == 1) {
+        /* stopped by a callback */
+        parser->status = 1;
+        return 1;
+    }
+    /* an incomplete token is carried over to the next chunk */
+    rest = (rc == PARSE_SUSPENDED) ? (length - json->pos) : 0U;
+    if (buffer == parser->carry) {
+        (void)memmove(parser->carry, &parser->carry[json->pos], rest);
+        parser->carried = rest;
+    } else {
+        parser->carried = 0;
+        if (append_carry(parser, &buffer[json->pos], rest) < 0) {
+            /* errno set */
+            parser->status = (-1);
+            set_last_error(JSON_ERR_MEMORY, NULL, parser->offset);
+            return (-1);
+        }
+    }
+    parser->escape = 0;
+    if ((parser->carried > 0) && (parser->carry[0] == '"'))
+        (void)scan_escaped(parser->carry, 1, parser->carried, &parser->escape);
+    errno = error;
+    return 0;
+}
+
+static int append_carry(struct json_parser* parser, const char* data, size_t length) {
+    char* carry = NULL;
+    size_t size;
+    assert(parser);
+    if ((parser->carried + length) > parser->capacity) {
+        size = (parser->capacity > 0) ? parser->capacity : CARRY_SIZE_MIN;
+        while ((size < (parser->carried + length)) && (size < ((size_t)-1 / 2U)))
+            size *= 2U;
+        if (size < (parser->carried + length)) {
+            errno = ENOMEM;
+            return (-1);
+        }
+        if ((carry = (char*)realloc(parser->carry, size)) == NULL) {
+            /* errno set */
+            return (-1);
+        }
+        parser->carry = carry;
+        parser->capacity = size;
+    }
+    if (length > 0)
+        (void)memcpy(&parser->carry[parser->carried], data, length);
+    parser->carried += length;
+    return 0;
+}
+
+static size_t scan_escaped(const char* buf, size_t idx, size_t len, int* escape) {
+    assert(buf);
+    assert(escape);
+    /* a backslash at the end of the last chunk escapes the first character */
+    if (*escape) {
+        if (idx >= len)
+            return len;
+        idx++;
+        *escape = 0;
+    }
+    while ((idx = find_special(buf, idx, len)) < len) {
+        if (buf[idx] != '\\')
+            return idx;  /* closing quote or control character */
+        if ((idx + 1U) >= len) {
+            *escape = 1;
+            return len;
+        }
+        idx += 2U;
+    }
+    return len;
+}
+
+/*  tree builder: event handler of the push parser without a handler. It
+ *  builds the same tree as parse_value() does, the nodes of the open objects
+ *  and arrays are kept on the parser stack.
+ */
+static int build_start_object(void* context) {
+    JSON json = &((struct json_parser*)context)->file;
+    struct json_node* node = NULL;
+    if ((node = new_node(json, JSON_OBJECT)) == NULL)
+        return build_error(json);
+    node->value.dict.head = NULL;
+    node->value.dict.curr = NULL;
+    node->value.dict.index = NULL;
+    json->frame[json->depth - 1].node = node;
+    return 0;
+}
+
+static int build_end_object(void* context) {
+    JSON json = &((struct json_parser*)context)->file;
+    json_node_t node = NULL;
+    /* note: the frame was popped just before */
+    if ((node = close_object(json, &json->frame[json->depth])) == NULL)
+        return build_error(json);
+    return build_value((struct json_parser*)context, node);
+}
+
+static int build_start_array(void* context) {
+    JSON json = &((struct json_parser*)context)->file;
+    struct json_node* node = NULL;
+    if ((node = new_node(json, JSON_ARRAY)) == NULL)
+        return build_error(json);
+    node->value.array.elem = NULL;
+    node->value.array.size = 0;
+    node->value.array.curr = (-1);
+    json->frame[json->depth - 1].node = node;
+    return 0;
+}
+
+static int build_end_array(void* context) {
+    JSON json = &((struct json_parser*)context)->file;
+    json_node_t node = NULL;
+    /* note: the frame was popped just before */
+    if ((node = close_array(json, &json->frame[json->depth])) == NULL)
+        return build_error(json);
+    return build_value((struct json_parser*)context, node);
+}
+
+static int build_key(void* context, const char* string, jsize_t length) {
+    JSON json = &((struct json_parser*)context)->file;
+    struct json_frame* frame = &json->frame[json->depth - 1];
+    struct json_member* next = NULL;
+    if ((next = (struct json_member*)arena_alloc(json->arena, sizeof(struct json_member))) == NULL)
+        return build_error(json);
+    if ((next->string = arena_strndup(json->arena, string, (size_t)length)) == NULL)
+        return build_error(json);
+    next->value = NULL;
+    next->next = NULL;
+    if (frame->last)
+        frame->last->next = next;
+    else
+        frame->node->value.dict.head = next;
+    frame->last = next;
+    frame->count++;
+    return 0;
+}
+
+static int build_string(void* context, const char* string, jsize_t length) {
+    JSON json = &((struct json_parser*)context)->file;
+    struct json_node* node = NULL;
+    if ((node = new_node(json, JSON_STRING)) == NULL)
+        return build_error(json);
+    if ((node->value.string = arena_strndup(json->arena, string, (size_t)length)) == NULL)
+        return build_error(json);
+    return build_value((struct json_parser*)context, node);
+}
+
+static int build_number(void* context, const char* string, jsize_t length) {
+    JSON json = &((struct json_parser*)context)->file;
+    struct json_node* node = NULL;
+    if ((node = new_node(json, JSON_NUMBER)) == NULL)
+        return build_error(json);
+    if ((node->value.number.string = arena_strndup(json->arena, string, (size_t)length)) == NULL)
+        return build_error(json);
+    node->value.number.flags = 0;
+    if (json->options & JSON_OPT_NUMBERS)
+        decode_number(&node->value.number, node->value.number.string);
+    return build_value((struct json_parser*)context, node);
+}
+
+static int build_literal(void* context, json_type_t type) {
+    /* note: literals are shared nodes (flyweights) */
+    switch (type) {
+    case JSON_TRUE: return build_value((struct json_parser*)context, &json_true);
+    case JSON_FALSE: return build_value((struct json_parser*)context, &json_false);
+    default: return build_value((struct json_parser*)context, &json_null);
+    }
+}
+
+static int build_value(struct json_parser* parser, json_node_t node) {
+    JSON json = &parser->file;
+    struct json_frame* frame = NULL;
+    if (json->depth == 0) {
+        /* the root value */
+        parser->root = node;
+        return 0;
+    }
+    frame = &json->frame[json->depth - 1];
+    if (frame->type == JSON_OBJECT) {
+        frame->last->value = node;
+        return 0;
+    }
+    if (push_value(json, node) < 0)
+        return build_error(json);
+    return 0;
+}
+
+static int build_error(JSON json) {
+    /* errno set */
+    json->error = (errno == ENOMEM) ? JSON_ERR_MEMORY : JSON_ERR_LIMIT;
+    json->fail = json->pos;
+    return 1;  /* stop */
+}
+
+/*  tape: the document as one array of tagged 64-bit words (in the order of
+ *  the text) and one buffer with all strings (zero-terminated). An object or
+ *  an array is enclosed by its start word, which holds the index of its end
+ *  word, and its end word, which holds the number of members or elements.
+ *  A member is a key word followed by the value. Strings and numbers hold
+ *  the offset of their text in the string buffer (decoded numbers are kept
+ *  right behind their text). The last word ends the root value.
+ *  The tape is recorded by the event parser, i.e. there is no tree at all.
+ */
+static struct json_tape* tape_buffer(const char* buffer, size_t length, unsigned int options) {
+    struct json_tape* tape = NULL;
+    struct json_recorder recorder;
+    json_file_t file;
+    int error;
+    assert(buffer);
+    if ((tape = (struct json_tape*)malloc(sizeof(struct json_tape))) == NULL) {
+        /* errno set */
+        set_last_error(JSON_ERR_MEMORY, NULL, 0);
+        return NULL;
+    }
+    (void)memset(tape, 0, sizeof(struct json_tape));
+    tape->options = options;
+    recorder.json = &file;
+    recorder.tape = tape;
+    if (parse_stream(&file, buffer, length, &tape_recorder, (void*)&recorder) != 0) {
+        /* errno set */
+        error = errno;
+        json_tape_free(tape);
+        errno = error;
+        return NULL;
+    }
+    /* the end of the root value */
+    if (tape_word(&file, tape, TAPE_WORD(TAPE_END, 1U)) != 0) {
+        /* errno set */
+        error = errno;
+        set_last_error(JSON_ERR_MEMORY, NULL, 0);
+        json_tape_free(tape);
+        errno = error;
+        return NULL;
+    }
+    return tape;
+}
+
+static size_t tape_skip(const struct json_tape* tape, size_t index) {
+    assert(tape);
+    assert(index < tape->count);
+    /* an object or an array is skipped at once (up to its end word) */
+    if ((TAPE_TAG(tape->word[index]) == TAPE_OBJECT) || (TAPE_TAG(tape->word[index]) == TAPE_ARRAY))
+        return TAPE_OFFSET(tape->word[index]) + 1U;
+    return index + 1U;
+}
+
+static void tape_decode(const struct json_tape* tape, size_t index, struct json_number* number) {
+    const char* string = NULL;
+    assert(tape);
+    assert(number);
+    string = &tape->string[TAPE_OFFSET(tape->word[index])];
+    number->string = (char*)string;
+    number->flags = TAPE_FLAGS(tape->word[index]);
+    if (number->flags)
+        (void)memcpy(&number->value, &string[strlen(string) + 1U], sizeof(number->value));
+    else
+        decode_number(number, string);
+}
+
+static int tape_word(JSON json, struct json_tape* tape, json_word_t word) {
+    json_word_t* temp = NULL;
+    size_t size;
+    assert(tape);
+    if (tape->count == tape->size) {
+        /* note: a token takes at least two characters (e.g. "1,") */
+        size = (tape->size > 0) ? (tape->size * 2U) : (json->len / 4U) + TAPE_SIZE_MIN;
+        if ((size < tape->size) || (size > ((size_t)-1 / sizeof(json_word_t)))) {
+            errno = ENOMEM;
+            return build_error(json);
+        }
+        if ((temp = (json_word_t*)realloc(tape->word, size * sizeof(json_word_t))) == NULL) {
+            /* errno set */
+            return build_error(json);
+        }
+        tape->word = temp;
+        tape->size = size;
+    }
+    tape->word[tape->count++] = word;
+    return 0;
+}
+
+static int tape_text(JSON json, struct json_tape* tape, const char* string, size_t length, size_t extra, size_t* offset) {
+    char* temp = NULL;
+    size_t size;
+    assert(tape);
+    assert(offset);
+    if ((length + extra + 1U) > (tape->capacity - tape->length)) {
+        /* note: the strings are shorter than the text (but for decoded numbers) */
+        size = (tape->capacity > 0) ? tape->capacity : json->len + TAPE_SIZE_MIN;
+        while ((size - tape->length) < (length + extra + 1U)) {
+            if (size > ((size_t)-1 / 2U)) {
+                errno = ENOMEM;
+                return build_error(json);
+            }
+            size *= 2U;
+        }
+        if ((temp = (char*)realloc(tape->string, size)) == NULL) {
+            /* errno set */
+            return build_error(json);
+        }
+        tape->string = temp;
+        tape->capacity = size;
+    }
+    *offset = tape->length;
+    (void)memcpy(&tape->string[tape->length], string, length);
+    tape->string[tape->length + length] = '\0';
+    tape->length += length + extra + 1U;
+    return 0;
+}
+
+static void tape_count(JSON json, size_t level) {
+    assert(json);
+    /* array elements are counted as values, object members as keys */
+    if ((level > 0) && (json->frame[level - 1].type == JSON_ARRAY))
+        json->frame[level - 1].count++;
+}
+
+static int tape_start(void* context, int tag) {
+    struct json_recorder* recorder = (struct json_recorder*)context;
+    JSON json = recorder->json;
+    /* note: the frame was pushed just before */
+    json->frame[json->depth - 1].base = recorder->tape->count;
+    tape_count(json, json->depth - 1);
+    return tape_word(json, recorder->tape, TAPE_WORD(tag, 0U));
+}
+
+static int tape_end(void* context) {
+    struct json_recorder* recorder = (struct json_recorder*)context;
+    JSON json = recorder->json;
+    struct json_frame* frame = &json->frame[json->depth];
+    struct json_tape* tape = recorder->tape;
+    /* note: the frame was popped just before */
+    if (frame->count > (size_t)INT_MAX) {
+        errno = EFBIG;
+        return build_error(json);
+    }
+    tape->word[frame->base] |= (json_word_t)tape->count;
+    return tape_word(json, tape, TAPE_WORD(TAPE_END, frame->count));
+}
+
+static int tape_start_object(void* context) {
+    return tape_start(context, TAPE_OBJECT);
+}
+
+static int tape_start_array(void* context) {
+    return tape_start(context, TAPE_ARRAY);
+}
+
+static int tape_key(void* context, const char* string, jsize_t length) {
+    struct json_recorder* recorder = (struct json_recorder*)context;
+    JSON json = recorder->json;
+    size_t offset = 0;
+    if (tape_text(json, recorder->tape, string, (size_t)length, 0U, &offset) != 0)
+        return 1;
+    json->frame[json->depth - 1].count++;
+    return tape_word(json, recorder->tape, TAPE_WORD(TAPE_KEY, offset));
+}
+
+static int tape_string(void* context, const char* string, jsize_t length) {
+    struct json_recorder* recorder = (struct json_recorder*)context;
+    JSON json = recorder->json;
+    size_t offset = 0;
+    if (tape_text(json, recorder->tape, string, (size_t)length, 0U, &offset) != 0)
+        return 1;
+    tape_count(json, json->depth);
+    return tape_word(json, recorder->tape, TAPE_WORD(TAPE_STRING, offset));
+}
+
+static int tape_number(void* context, const char* string, jsize_t length) {
+    struct json_recorder* recorder = (struct json_recorder*)context;
+    JSON json = recorder->json;
+    struct json_tape* tape = recorder->tape;
+    struct json_number number;
+    size_t offset = 0;
+    number.flags = 0;
+    if (tape->options & JSON_OPT_NUMBERS) {
+        /* the decoded value is kept right behind the text */
+        if (tape_text(json, tape, string, (size_t)length, sizeof(number.value), &offset) != 0)
+            return 1;
+        decode_number(&number, &tape->string[offset]);
+        (void)memcpy(&tape->string[offset + (size_t)length + 1U], &number.value, sizeof(number.value));
+    } else {
+        if (tape_text(json, tape, string, (size_t)length, 0U, &offset) != 0)
+            return 1;
+    }
+    tape_count(json, json->depth);
+    return tape_word(json, tape, TAPE_WORD(TAPE_NUMBER, offset) | ((json_word_t)number.flags << TAPE_FLAG_SHIFT));
+}
+
+static int tape_literal(void* context, json_type_t type) {
+    struct json_recorder* recorder = (struct json_recorder*)context;
+    JSON json = recorder->json;
+    tape_count(json, json->depth);
+    switch (type) {
+    case JSON_TRUE: return tape_word(json, recorder->tape, TAPE_WORD(TAPE_TRUE, 0U));
+    case JSON_FALSE: return tape_word(json, recorder->tape, TAPE_WORD(TAPE_FALSE, 0U));
+    default: return tape_word(json, recorder->tape, TAPE_WORD(TAPE_NULL, 0U));
+    }
+}
+
+/*  JSON path: a reference token is an array index, if it is "0" or a number
+ *  without leading zeros (that fits into an int), otherwise -1 (e.g. "-").
+ */
+static int path_index(const char* string) {
+    int index = 0;
+    assert(string);
+    if ((string[0] == '0') && (string[1] == '\0'))
+        return 0;
+    if ((string[0] < '1') || (string[0] > '9'))
+        return (-1);
+    while (*string) {
+        if ((*string < '0') || (*string > '9'))
+            return (-1);
+        if (index > ((INT_MAX - (*string - '0')) / 10))
+            return (-1);
+        index = (index * 10) + (*string++ - '0');
+    }
+    return index;
+}
+
+static json_node_t path_step(json_node_t node, const struct json_token* token) {
+    struct json_member* member = NULL;
+    assert(node);
+    assert(token);
+    if (node->type == JSON_OBJECT) {
+        if (node->value.dict.head && ((member = find_hashed(node, token->string, token->hash)) != NULL))
+            return member->value;
+    } else if (node->type == JSON_ARRAY) {
+        if ((token->index >= 0) && (token->index < node->value.array.size))
+            return node->value.array.elem[token->index];
+    }
+    return NULL;
+}
+
+static size_t path_prefix(const struct json_path* path, const struct json_path* other) {
+    size_t i;
+    assert(path);
+    assert(other);
+    for (i = 0U; (i < path->count) && (i < other->count); i++) {
+        if ((path->token[i].hash != other->token[i].hash) || strcmp(path->token[i].string, other->token[i].string))
+            break;
+    }
+    return i;
+}
+
+static int path_compare(const void* lhs, const void* rhs) {
+    const struct json_path* path = ((const struct json_lookup*)lhs)->path;
+    const struct json_path* other = ((const struct json_lookup*)rhs)->path;
+    size_t i = path_prefix(path, other);
+    if ((i < path->count) && (i < other->count))
+        return strcmp(path->token[i].string, other->token[i].string);
+    if (path->count != other->count)
+        return (path->count < other->count) ? (-1) : 1;
+    return 0;
+}
+
+#if (THREADS_SUPPORTED != 0)
+/*  parallel parser: the text of a top-level array is split into one chunk per
+ *  thread. (1) The chunks are pre-scanned in parallel for quotes and brackets,
+ *  both as if they started outside and inside a string. (2) The string state
+ *  and the depth at the begin of each chunk are then known one after the
+ *  other. (3) Each thread parses the elements of a slice, from the first comma
+ *  at depth 1 in its chunk to the first one in the next chunk (or to the
+ *  closing bracket), into its own arena. (4) The elements are put together
+ *  into one array, and the chunks of the arenas are handed over to the
+ *  document. As the slices fit together, the result is the same as of the
+ *  sequential parser.
+ *  Returns the array, or NULL if the text cannot be parsed this way.
+ */
+static json_node_t parse_parallel(JSON json, int threads) {
+    struct json_slice* slice = NULL;
+    struct json_node* node = NULL;
+    struct json_chunk* chunk = NULL;
+    size_t first, step, close = 0, count = 0, i;
+    int string = 0, k, n;
+    long depth = 0;
+    assert(json);
+    first = skip_whitespace(json->buf, 0, json->len);
+    if ((threads < 2) || (first >= json->len) || (json->buf[first] != '['))
+        return NULL;
+    if ((size_t)threads > ((json->len - first) / SLICE_SIZE_MIN))
+        threads = (int)((json->len - first) / SLICE_SIZE_MIN);
+    if ((threads < 2) ||
+        ((slice = (struct json_slice*)calloc((size_t)threads, sizeof(struct json_slice))) == NULL)) {
+        errno = 0;
+        return NULL;
+    }
+    /* (1) pre-scan of the chunks */
+    step = (json->len - first) / (size_t)threads;
+    for (k = 0; k < threads; k++) {
+        slice[k].buf = json->buf;
+        slice[k].len = json->len;
+        slice[k].begin = first + (step * (size_t)k);
+        slice[k].end = (k < (threads - 1)) ? (slice[k].begin + step) : json->len;
+    }
+    run_threads(scan_chunk, slice, threads);
+    /* (2) string state and depth at the begin of the chunks (up to
+     *     the chunk where the array is closed) */
+    for (k = 0, n = threads; k < threads; k++) {
+        slice[k].string = string;
+        slice[k].depth = depth;
+        if ((k > 0) && (depth < 1)) {
+            n = k;
+            break;
+        }
+        string ^= slice[k].quotes;
+        depth += slice[k].delta[slice[k].string];
+    }
+    if (n < 2) {
+        /* a small array (or not JSON at all) */
+        free(slice);
+        errno = 0;
+        return NULL;
+    }
+    /* (3) parsing of the slices */
+    for (k = 0; k < n; k++) {
+        slice[k].next = (k < (n - 1)) ? &slice[k + 1] : NULL;
+        /* note: the slices are not parsed in-situ, the text must be
+         *       unchanged if it has to be parsed as usual after all */
+        slice[k].file.options = json->options & ~JSON_OPT_INSITU;
+        arena_init(&slice[k].arena, slice[k].end - slice[k].begin);
+    }
+    run_threads(parse_slice, slice, n);
+    /* (4) the elements of all slices into one array: each slice ends at
+     *     the comma where the next one begins, the last one at the closing
+     *     bracket (empty slices are skipped) */
+    for (k = 0; k < n; k++) {
+        if (slice[k].error != 0)
+            break;
+        if (slice[k].file.buf == NULL)
+            continue;
+        if (close)
+            break;
+        if ((slice[k].file.pos < json->len) && (json->buf[slice[k].file.pos] == ']'))
+            close = slice[k].file.pos;
+        else if ((slice[k].file.pos != slice[k].stop) || (slice[k].stop >= json->len) || (json->buf[slice[k].stop] != ','))
+            break;
+        count += slice[k].file.top;
+    }
+    if ((k == n) && close && (count <= (size_t)INT_MAX) &&
+        ((node = new_node(json, JSON_ARRAY)) != NULL) &&
+        ((node->value.array.elem = (struct json_node**)arena_alloc(json->arena, count * sizeof(struct json_node*))) != NULL)) {
+        for (k = 0, i = 0; k < n; k++) {
+            if (slice[k].file.top > 0)
+                (void)memcpy(&node->value.array.elem[i], slice[k].file.stack, slice[k].file.top * sizeof(struct json_node*));
+            i += slice[k].file.top;
+            /* the chunks of the arena go behind the current chunk of the document */
+            if ((chunk = slice[k].arena.head) != NULL) {
+                while (chunk->next)
+                    chunk = chunk->next;
+                chunk->next = json->arena->head->next;
+                json->arena->head->next = slice[k].arena.head;
+                slice[k].arena.head = NULL;
+            }
+        }
+        node->value.array.size = (int)count;
+        node->value.array.curr = (-1);
+        json->pos = close + 1U;
+    } else {
+        node = NULL;
+    }
+    for (k = 0; k < n; k++) {
+        arena_free(&slice[k].arena);
+        free(slice[k].file.stack);
+        free(slice[k].file.frame);
+    }
+    free(slice);
+    errno = 0;
+    return node;
+}
+
+static void* scan_chunk(void* context) {
+    struct json_slice* slice = (struct json_slice*)context;
+    const char* buf = slice->buf;
+    size_t pos = slice->begin, end = slice->end;
+    long delta[2];
+    int q = 0;
+#if (SIMD_SSE2 != 0)
+    const __m128i quote = _mm_set1_epi8('"'), backslash = _mm_set1_epi8('\\');
+    const __m128i lower = _mm_set1_epi8(0x20), open = _mm_set1_epi8('{'), close = _mm_set1_epi8('}');
+    __m128i lo, hi;
+    unsigned int quotes, opens, closes, even, escaped, carry, mask, bit;
+    long total, part;
+#endif
+    /* note: the changes of depth are kept in local variables, as
+     *       the characters of the text could alias the slice */
+    delta[0] = delta[1] = 0;
+#if (SIMD_SSE2 != 0)
+    /* blocks of 32 characters: the string state of each character is the
+     * prefix XOR of the quotes (that are not escaped), and the brackets are
+     * counted for both assumptions at once (without branches) */
+    carry = (unsigned int)is_escaped(buf, pos);
+    for (; (pos + 32U) <= end; pos += 32U) {
+        lo = _mm_loadu_si128((const __m128i*)&buf[pos]);
+        hi = _mm_loadu_si128((const __m128i*)&buf[pos + 16U]);
+        quotes = (unsigned int)_mm_movemask_epi8(_mm_cmpeq_epi8(lo, quote)) |
+                ((unsigned int)_mm_movemask_epi8(_mm_cmpeq_epi8(hi, quote)) << 16);
+        mask = (unsigned int)_mm_movemask_epi8(_mm_cmpeq_epi8(lo, backslash)) |
+              ((unsigned int)_mm_movemask_epi8(_mm_cmpeq_epi8(hi, backslash)) << 16);
+        lo = _mm_or_si128(lo, lower);  /* '[' to '{' and ']' to '}' */
+        hi = _mm_or_si128(hi, lower);
+        opens = (unsigned int)_mm_movemask_epi8(_mm_cmpeq_epi8(lo, open)) |
+               ((unsigned int)_mm_movemask_epi8(_mm_cmpeq_epi8(hi, open)) << 16);
+        closes = (unsigned int)_mm_movemask_epi8(_mm_cmpeq_epi8(lo, close)) |
+                ((unsigned int)_mm_movemask_epi8(_mm_cmpeq_epi8(hi, close)) << 16);
+        if ((mask | carry) != 0U) {
+            /* a backslash escapes the next character (unless it is escaped) */
+            escaped = carry;
+            carry = 0U;
+            mask &= ~escaped;
+            while (mask != 0U) {
+                bit = mask & (~mask + 1U);
+                if (bit == 0x80000000U)
+                    carry = 1U;
+                else
+                    escaped |= bit << 1;
+                mask &= ~(bit | (bit << 1));
+            }
+            quotes &= ~escaped;
+        }
+        even = quotes;
+        even ^= even << 1;
+        even ^= even << 2;
+        even ^= even << 4;
+        even ^= even << 8;
+        even ^= even << 16;
+        even &= 0xFFFFFFFFU;
+        total = (long)count_bits(opens) - (long)count_bits(closes);
+        part = (long)count_bits(opens & ~even) - (long)count_bits(closes & ~even);
+        delta[q] += part;
+        delta[q ^ 1] += total - part;
+        q ^= (int)(even >> 31);
+    }
+#endif
+    for (; pos < end; pos++) {
+        switch (buf[pos]) {
+        case '"':
+            if (!is_escaped(buf, pos))
+                q ^= 1;
+            break;
+        case '[':
+        case '{':
+            delta[q]++;
+            break;
+        case ']':
+        case '}':
+            delta[q]--;
+            break;
+        default:
+            break;
+        }
+    }
+    slice->delta[0] = delta[0];
+    slice->delta[1] = delta[1];
+    slice->quotes = q;
+    return NULL;
+}
+
+static void* parse_slice(void* context) {
+    struct json_slice* slice = (struct json_slice*)context;
+    JSON json = &slice->file;
+    json_node_t value = NULL;
+    size_t start;
+    /* the slice: from the first comma at depth 1 in the chunk (or from the
+     * opening bracket) to the first one in the next chunk (or to the end) */
+    if (slice->depth == 0) {
+        start = slice->begin + 1U;
+    } else {
+        start = find_split(slice->buf, slice->begin, slice->len, slice->string, slice->depth);
+        if ((start >= slice->len) || (slice->buf[start] != ','))
+            return NULL;  /* no element begins in the chunk */
+        start++;
+    }
+    slice->stop = slice->next ? find_split(slice->buf, slice->next->begin, slice->len, slice->next->string, slice->next->depth) : slice->len;
+    if (start > slice->stop)
+        return NULL;  /* the next chunk begins with the same element */
+    json->buf = slice->buf;
+    json->len = slice->stop;
+    json->pos = start;
+    json->arena = &slice->arena;
+    /* the elements are collected on the scratch stack, as of an array */
+    if (push_frame(json, JSON_ARRAY, NULL) < 0) {
+        /* errno set */
+        slice->error = errno;
+        return NULL;
+    }
+    json->root = 1;
+    for (;;) {
+        if (((value = parse_value(json)) == NULL) || (push_value(json, value) < 0)) {
+            /* errno set */
+            slice->error = errno ? errno : EINVAL;
+            return NULL;
+        }
+        if (lookahead(json) != ',')
+            break;
+        (void)get_char(json);
+    }
+    return NULL;
+}
+
+static size_t find_split(const char* buf, size_t pos, size_t len, int string, long depth) {
+    /* the first comma at depth 1, or the closing bracket at depth 0 */
+    for (; pos < len; pos++) {
+        if (buf[pos] == '"') {
+            if (!is_escaped(buf, pos))
+                string ^= 1;
+        } else if (!string) {
+            if ((buf[pos] == '[') || (buf[pos] == '{'))
+                depth++;
+            else if (((buf[pos] == ']') || (buf[pos] == '}')) && (--depth < 1))
+                break;
+            else if ((buf[pos] == ',') && (depth == 1))
+                break;
+        }
+    }
+    return pos;
+}
+
+static int is_escaped(const char* buf, size_t pos) {
+    size_t n = 0;
+    /* an odd number of backslashes (in a string) */
+    while ((pos > n) && (buf[pos - n - 1] == '\\'))
+        n++;
+    return (int)(n & 1U);
+}
+
+#if (SIMD_SSE2 != 0)
+static unsigned int count_bits(unsigned int mask) {
+#if defined(_MSC_VER)
+    unsigned int n = 0U;
+    for (; mask != 0U; mask &= mask - 1U)
+        n++;
+    return n;
+#else
+    return (unsigned int)__builtin_popcount(mask);
+#endif
+}
+#endif
+
+static void run_threads(void* (*task)(void*), struct json_slice* slice, int count) {
+    pthread_t* thread = NULL;
+    int k, n = 0;
+    /* the first task is run by the calling thread, and if
+     * no thread can be created, then the task is run too */
+    if (count > 1)
+        thread = (pthread_t*)malloc((size_t)(count - 1) * sizeof(pthread_t));
+    for (k = 1; k < count; k++) {
+        if (thread && (pthread_create(&thread[n], NULL, task, (void*)&slice[k]) == 0))
+            n++;
+        else
+            (void)task((void*)&slice[k]);
+    }
+    (void)task((void*)&slice[0]);
+    for (k = 0; k < n; k++)
+        (void)pthread_join(thread[k], NULL);
+    free(thread);
+}
+#endif
+
+static int count_processors(void) {
+#if (THREADS_SUPPORTED != 0) && defined(_SC_NPROCESSORS_ONLN)
+    int error = errno;
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+    errno = error;
+    return ((n > 0L) && (n <= 1024L)) ? (int)n : 1;
+#else
+    return 1;
+#endif
+}
+
+static int fill_batch(struct json_lines* lines, struct json_batch* batch) {
+    size_t size = JSON_LINES_BATCH;
+    size_t from, n;
+    char* text = NULL;
+    /* (1) the batch begins with the incomplete line of the last batch */
+    while (size < (lines->carried * 2U))
+        size *= 2U;
+    if (batch->size < size) {
+        if ((text = (char*)realloc(batch->text, size)) == NULL) {
+            /* errno set */
+            lines->code = errno;
+            return (-1);
+        }
+        batch->text = text;
+        batch->size = size;
+    }
+    if (lines->carried > 0)
+        (void)memcpy(batch->text, lines->carry, lines->carried);
+    batch->length = lines->carried;
+    from = 0;
+    /* (2) fill it up with complete lines, i.e. up to the last line feed */
+    for (;;) {
+        n = fread(&batch->text[batch->length], 1, batch->size - batch->length, lines->fp);
+        batch->length += n;
+        if (n == 0) {
+            if (ferror(lines->fp)) {
+                /* read error: the complete lines are in the batches
+                 * before (the error is returned after their records,
+                 * see json_lines_next), the incomplete one is dropped */
+                lines->code = errno ? errno : EIO;
+                return (-1);
+            }
+            /* end of file: the last line has no line feed */
+            lines->carried = 0;
+            lines->eof = 1;
+            break;
+        }
+        for (n = batch->length; (n > from) && (batch->text[n - 1] != '\n'); n--)
+            ;
+        if (n > from) {
+            /* the rest is carried over to the next batch */
+            lines->carried = batch->length - n;
+            if (lines->carried > lines->capacity) {
+                if ((text = (char*)realloc(lines->carry, lines->carried)) == NULL) {
+                    /* errno set: the complete lines of this batch are
+                     * returned, then the error (the rest is not read) */
+                    lines->code = errno;
+                    lines->carried = 0;
+                    lines->eof = 1;
+                    batch->length = n;
+                    break;
+                }
+                lines->carry = text;
+                lines->capacity = lines->carried;
+            }
+            if (lines->carried > 0)
+                (void)memcpy(lines->carry, &batch->text[n], lines->carried);
+            batch->length = n;
+            break;
+        }
+        /* a line longer than the batch: make it larger */
+        from = batch->length;
+        if (batch->length == batch->size) {
+            if ((text = (char*)realloc(batch->text, batch->size * 2U)) == NULL) {
                 /* errno set */
-                free(string);
-                free_object(node);
-                return NULL;
+                lines->code = errno;
+                return (-1);
+            }
+            batch->text = text;
+            batch->size *= 2U;
+        }
+    }
+    batch->offset = lines->offset;
+    lines->offset += batch->length;
+    batch->lines = 0;
+    batch->count = 0;
+    batch->next = 0;
+    batch->code = 0;
+    return (batch->length > 0) ? 1 : 0;
+}
+
+static void parse_lines(struct json_batch* batch, unsigned int options) {
+    struct json_record* record = NULL;
+    const char* eol = NULL;
+    size_t pos = 0, end, i;
+    long line = 0;
+    while (pos < batch->length) {
+        /* (1) the next line (without line feed) */
+        eol = (const char*)memchr(&batch->text[pos], '\n', batch->length - pos);
+        end = eol ? (size_t)(eol - batch->text) : batch->length;
+        for (i = pos; (i < end) && IS_WHITESPACE(batch->text[i]); i++)
+            ;
+        /* (2) parse it, if it is not empty */
+        if (i < end) {
+            if (batch->count == batch->capacity) {
+                i = batch->capacity ? batch->capacity * 2U : RECORD_SIZE_MIN;
+                if ((record = (struct json_record*)realloc(batch->record, i * sizeof(struct json_record))) == NULL) {
+                    /* errno set */
+                    batch->code = errno;
+                    break;
+                }
+                batch->record = record;
+                batch->capacity = i;
             }
-            if ((next = (struct json_member*)malloc(sizeof(struct json_member))) == NULL) {
+            record = &batch->record[batch->count++];
+            record->offset = pos;
+            record->line = line;
+            if ((record->root = json_parse_ex(&batch->text[pos], (jsize_t)(end - pos), options)) == NULL) {
                 /* errno set */
-                free(string);
-                free_value(value);
-                free_object(node);
-                return NULL;
+                record->code = errno;
+                record->error = last_error;
             }
-            next->string = string;
-            next->value = value;
-            next->next = NULL;
-            curr->next = next;
-            /* get next member, if any */
-            curr = next;
         }
-    } else {
-        /* skip whitespaces */
-        (void)lookahead(json);
+        if (eol)
+            line++;
+        pos = end + 1;
+    }
+    batch->lines = line;
+}
+
+static void take_batch(struct json_lines* lines, int slot) {
+    /* note: the mutex is locked, and the batch is the next one to be parsed */
+    assert(slot == lines->work);
+    lines->batch[slot].state = BATCH_BUSY;
+    lines->work = (lines->work + 1) % lines->slots;
+}
+
+static void free_batch(struct json_batch* batch) {
+    /* the documents that have not been returned */
+    while (batch->next < batch->count) {
+        json_free(batch->record[batch->next].root);
+        batch->next++;
+    }
+    free(batch->record);
+    free(batch->text);
+}
+
+#if (THREADS_SUPPORTED != 0)
+static void* lines_worker(void* context) {
+    struct json_lines* lines = (struct json_lines*)context;
+    struct json_batch* batch = NULL;
+    assert(lines);
+    lines_lock(lines);
+    for (;;) {
+        /* (1) wait for the next batch to be parsed */
+        while (!lines->quit && (lines->batch[lines->work].state != BATCH_READY))
+            (void)pthread_cond_wait(&lines->ready, &lines->mutex);
+        if (lines->quit)
+            break;
+        batch = &lines->batch[lines->work];
+        take_batch(lines, (int)(batch - lines->batch));
+        /* (2) parse its lines without the lock */
+        lines_unlock(lines);
+        parse_lines(batch, lines->options);
+        lines_lock(lines);
+        batch->state = BATCH_DONE;
+        (void)pthread_cond_broadcast(&lines->done);
+    }
+    lines_unlock(lines);
+    return NULL;
+}
+#endif
+
+static void lines_lock(struct json_lines* lines) {
+#if (THREADS_SUPPORTED != 0)
+    if (lines->thread)
+        (void)pthread_mutex_lock(&lines->mutex);
+#else
+    (void)lines;
+#endif
+}
+
+static void lines_unlock(struct json_lines* lines) {
+#if (THREADS_SUPPORTED != 0)
+    if (lines->thread)
+        (void)pthread_mutex_unlock(&lines->mutex);
+#else
+    (void)lines;
+#endif
+}
+
+static int dump_file(json_node_t node, const char* filename, int indent) {
+    FILE* fp = stdout;
+    int error;
+    if (filename && ((fp = fopen(filename, "w")) == NULL)) {
+        /* errno set */
+        return (-1);
+    }
+    if ((error = (dump_stream(node, indent, write_file, (void*)fp) < 0) ? errno : 0) == 0)
+        error = (fputc('\n', fp) == EOF) ? (errno ? errno : EIO) : 0;
+    if ((fflush(fp) != 0) && !error)
+        error = errno ? errno : EIO;
+    if (filename && (fclose(fp) != 0) && !error)
+        error = errno ? errno : EIO;
+    errno = error;
+    return error ? (-1) : 0;
+}
+
+static int dump_stream(json_node_t node, int indent, json_write_t write, void* context) {
+    struct json_writer writer;
+    (void)memset(&writer, 0, sizeof(struct json_writer));
+    writer.write = write;
+    writer.context = context;
+    writer.indent = indent;
+    if ((writer.buffer = (char*)malloc(WRITE_SIZE)) == NULL) {
+        /* errno set */
+        return (-1);
+    }
+    writer.size = WRITE_SIZE;
+    dump_value(node, (-1), &writer);
+    write_flush(&writer);
+    free(writer.buffer);
+    errno = writer.error;
+    return writer.error ? (-1) : 0;
+}
+
+static int write_file(void* context, const char* data, jsize_t length) {
+    assert(context);
+    return (fwrite(data, 1U, (size_t)length, (FILE*)context) == (size_t)length) ? 0 : (-1);
+}
+
+/*  dump an object or an array (without recursion): the open ones are kept on
+ *  a stack (on the heap), the other values are written as they are visited.
+ *  Note: keys are indented by one level, values of members by three levels
+ *        and elements by two levels (relative to the brackets). Minified,
+ *        there are no line feeds and no indentation at all.
+ */
+static void dump_value(json_node_t node, int depth, struct json_writer* writer) {
+    struct json_cursor* stack = NULL;
+    struct json_cursor* cursor = NULL;
+    struct json_member* member = NULL;
+    size_t top = 0, size = 0;
+    assert(writer);
+    while (node || (top > 0)) {
+        if (node) {
+            /* (1) write a value (or the opening bracket) */
+            depth++;
+            switch (node->type) {
+            case JSON_OBJECT:
+            case JSON_ARRAY:
+                if ((top == size) && ((cursor = grow_cursor(&stack, &size)) == NULL)) {
+                    /* errno set */
+                    writer->error = errno;
+                    top = 0;
+                    break;
+                }
+                cursor = &stack[top++];
+                cursor->node = node;
+                cursor->member = (node->type == JSON_OBJECT) ? node->value.dict.head : NULL;
+                cursor->index = 0;
+                cursor->depth = depth;
+                write_indent(writer, depth);
+                write_char(writer, (node->type == JSON_OBJECT) ? '{' : '[');
+                if (writer->indent)
+                    write_char(writer, '\n');
+                break;
+            case JSON_STRING: dump_string(node, depth, writer); break;
+            case JSON_NUMBER: dump_number(node, depth, writer); break;
+            case JSON_TRUE: dump_literal(node, depth, writer); break;
+            case JSON_FALSE: dump_literal(node, depth, writer); break;
+            case JSON_NULL: dump_literal(node, depth, writer); break;
+            default: break;
+            }
+            node = NULL;
+            continue;
+        }
+        /* (2) next member or element of the innermost object or array */
+        cursor = &stack[top - 1];
+        depth = cursor->depth;
+        if (cursor->node->type == JSON_OBJECT) {
+            if ((member = cursor->member) != NULL) {
+                if (member != cursor->node->value.dict.head) {
+                    write_char(writer, ',');
+                    if (writer->indent)
+                        write_char(writer, '\n');
+                }
+                write_indent(writer, depth + 1);
+                if (member->string) {
+                    write_char(writer, '"');
+                    write_text(writer, member->string, strlen(member->string));
+                    write_char(writer, '"');
+                }
+                write_char(writer, ':');
+                if (writer->indent)
+                    write_char(writer, '\n');
+                cursor->member = member->next;
+                node = member->value;
+                depth += 2;
+                continue;
+            }
+        } else {
+            if (cursor->index < cursor->node->value.array.size) {
+                if (cursor->index > 0) {
+                    write_char(writer, ',');
+                    if (writer->indent)
+                        write_char(writer, '\n');
+                }
+                node = cursor->node->value.array.elem[cursor->index++];
+                depth += 1;
+                continue;
+            }
+        }
+        /* (3) write the closing bracket */
+        if (writer->indent)
+            write_char(writer, '\n');
+        write_indent(writer, depth);
+        write_char(writer, (cursor->node->type == JSON_OBJECT) ? '}' : ']');
+        top--;
+    }
+    free(stack);
+}
+
+static struct json_cursor* grow_cursor(struct json_cursor** stack, size_t* size) {
+    struct json_cursor* cursor = NULL;
+    size_t length;
+    assert(stack);
+    assert(size);
+    length = (*size > 0) ? (*size * 2U) : FRAME_SIZE_MIN;
+    if ((length < *size) || (length > ((size_t)-1 / sizeof(struct json_cursor)))) {
+        errno = ENOMEM;
+        return NULL;
+    }
+    if ((cursor = (struct json_cursor*)realloc(*stack, length * sizeof(struct json_cursor))) == NULL) {
+        /* errno set */
+        return NULL;
+    }
+    *stack = cursor;
+    *size = length;
+    return cursor;
+}
+
+/*  <object>     : '{' '}'
+ *               | '{' <members> '}'
+ *               ;
+ *  <members>    : <member>
+ *               | <member> ',' <members>
+ *               ;
+ *  <member>     : <string> ':' <value>
+ *               ;
+ */
+static json_node_t open_object(JSON json) {
+    struct json_node* node = NULL;
+    assert(json);
+    /* note: on error the arena is released as a whole, i.e.
+     *       partially parsed objects must not be freed here */
+    if ((node = new_node(json, JSON_OBJECT)) == NULL) {
+        /* errno set */
+        return NULL;
+    }
+    node->value.dict.head = NULL;
+    node->value.dict.curr = NULL;
+    node->value.dict.index = NULL;
+    if (push_frame(json, JSON_OBJECT, node) < 0) {
+        /* errno set */
+        return NULL;
     }
-    if (get_char(json) != '}') {
-        free_object(node);
-        errno = EINVAL; /* FIXME: error code */
+    if (get_char(json) != '{') {
+        parse_error(json, JSON_ERR_SYNTAX);
         return NULL;
     }
-    DEBUG_OBJECT(node);
     return node;
 }
 
-static void free_object(json_node_t node) {
-    struct json_member* curr = NULL;
-    struct json_member* temp = NULL;
-
-    if (node && (node->type == JSON_OBJECT)) {
-        curr = node->value.dict.head;
-        while (curr) {
-            temp = curr;
-            curr = temp->next;
-            if (temp->value)
-                free_value(temp->value);
-            if (temp->string)
-                free(temp->string);
-            free(temp);
-        }
-        free(node);
+static int next_member(JSON json) {
+    struct json_frame* frame = NULL;
+    struct json_member* next = NULL;
+    assert(json);
+    assert(json->depth > 0);
+    frame = &json->frame[json->depth - 1];
+    if ((next = (struct json_member*)arena_alloc(json->arena, sizeof(struct json_member))) == NULL) {
+        /* errno set */
+        return (-1);
     }
+    /* get member key (as string) */
+    if ((next->string = get_string(json)) == NULL) {
+        /* errno set */
+        return (-1);
+    }
+    if (lookahead(json) != ':') {
+        parse_error(json, JSON_ERR_SYNTAX);
+        return (-1);
+    }
+    (void)get_char(json);
+    /* the member value (as JSON value) follows */
+    next->value = NULL;
+    next->next = NULL;
+    if (frame->last)
+        frame->last->next = next;
+    else
+        frame->node->value.dict.head = next;
+    frame->last = next;
+    frame->count++;
+    return 0;
 }
 
-static void dump_object(json_node_t node, int depth, FILE* fp) {
-    struct json_member* curr = NULL;
-    int i;
-    assert(fp);
-    if (node && (node->type == JSON_OBJECT)) {
-        /* opening bracket */
-        for (i = 0; i < depth; i++) {
-            fputc(' ', fp); fputc(' ', fp);
-        }
-        fputc('{', fp); fputc('\n', fp);
-        if (node->value.dict.head) {
-            /* first member */
-            curr = node->value.dict.head;
-            for (i = 0; i < depth + 1; i++) {
-                fputc(' ', fp); fputc(' ', fp);
-            }
-            if (curr->string)
-                fprintf(fp, "\"%s\"", curr->string);
-            fputc(':', fp); fputc('\n', fp);
-            if (curr->value)
-                dump_value(curr->value, depth + 2, fp);
-            /* other members, if any */
-            curr = curr->next;
-            while (curr != NULL) {
-                fputc(',', fp); fputc('\n', fp);
-                for (i = 0; i < depth + 1; i++) {
-                    fputc(' ', fp); fputc(' ', fp);
-                }
-                if (curr->string)
-                    fprintf(fp, "\"%s\"", curr->string);
-                fputc(':', fp); fputc('\n', fp);
-                if (curr->value)
-                    dump_value(curr->value, depth + 2, fp);
-                curr = curr->next;
-            }
-        }
-        fputc('\n', fp);
-        /* closing bracket */
-        for (i = 0; i < depth; i++) {
-            fputc(' ', fp); fputc(' ', fp);
+static json_node_t close_object(JSON json, struct json_frame* frame) {
+    assert(json);
+    assert(frame);
+    /* large objects get a hash index */
+    if ((JSON_HASH_THRESHOLD > 0) && (frame->count >= (size_t)JSON_HASH_THRESHOLD)) {
+        if (make_index(json, frame->node, frame->count) < 0) {
+            /* errno set */
+            return NULL;
         }
-        fputc('}', fp);
-        fflush(fp);
     }
+    DEBUG_OBJECT(frame->node);
+    return frame->node;
 }
 
 /*  <array>      : '[' ']'
@@ -810,123 +5280,52 @@ static void dump_object(json_node_t node, int depth, FILE* fp) {
  *  <element>    : <value>
  *               ;
  */
-static json_node_t parse_array(JSON json) {
+static json_node_t open_array(JSON json) {
     struct json_node* node = NULL;
-    struct json_node* value = NULL;
-    struct json_element* curr = NULL;
-    struct json_element* next = NULL;
-    int index = 0;
-
-    if (get_char(json) != '[') {
-        errno = EINVAL; /* FIXME: error code */
+    assert(json);
+    /* note: on error the arena is released as a whole, i.e.
+     *       partially parsed arrays must not be freed here */
+    if ((node = new_node(json, JSON_ARRAY)) == NULL) {
+        /* errno set */
         return NULL;
     }
-    if ((node = (struct json_node*)malloc(sizeof(struct json_node))) == NULL) {
+    node->value.array.elem = NULL;
+    node->value.array.size = 0;
+    node->value.array.curr = (-1);
+    /* the elements are collected on the scratch stack */
+    if (push_frame(json, JSON_ARRAY, node) < 0) {
         /* errno set */
         return NULL;
     }
-    node->type = JSON_ARRAY;
-    node->value.array.head = NULL;
-    node->value.array.curr = NULL;
-    /* first element (optional) */
-    if ((value = parse_value(json)) != NULL) {
-        if ((curr = (struct json_element*)malloc(sizeof(struct json_element))) == NULL) {
-            /* errno set */
-            free_value(value);
-            free(node);
-            return NULL;
-        }
-        curr->index = index++;
-        curr->value = value;
-        curr->next  = NULL;
-        node->value.array.head = curr;
-        /* loop over array elements, if more */
-        while (lookahead(json) == ',') {
-            if (get_char(json) != ',') {
-                free_array(node);
-                errno = EINVAL; /* FIXME: error code */
-                return NULL;
-            }
-            if ((value = parse_value(json)) == NULL) {
-                /* errno set */
-                free_array(node);
-                return NULL;
-            }
-            if ((next = (struct json_element*)malloc(sizeof(struct json_element))) == NULL) {
-                /* errno set */
-                free_value(value);
-                free_array(node);
-                return NULL;
-            }
-            next->index = index++;
-            next->value = value;
-            next->next = NULL;
-            curr->next = next;
-            /* get next element, if any */
-            curr = next;
-        }
-    } else {
-        /* skip whitespaces */
-        (void)lookahead(json);
-    }
-    if (get_char(json) != ']') {
-        free_array(node);
-        errno = EINVAL; /* FIXME: error code */
+    if (get_char(json) != '[') {
+        parse_error(json, JSON_ERR_SYNTAX);
         return NULL;
     }
-    DEBUG_ARRAY(node);
     return node;
 }
 
-static void free_array(json_node_t node) {
-    struct json_element* curr = NULL;
-    struct json_element* temp = NULL;
-
-    if (node && (node->type == JSON_ARRAY)) {
-        curr = node->value.array.head;
-        while (curr) {
-            temp = curr;
-            curr = temp->next;
-            if (temp->value)
-                free_value(temp->value);
-            free(temp);
-        }
-        free(node);
-    }
-}
-
-static void dump_array(json_node_t node, int depth, FILE* fp) {
-    struct json_element* curr = NULL;
-    int i;
-    assert(fp);
-    if (node && (node->type == JSON_ARRAY)) {
-        /* opening bracket */
-        for (i = 0; i < depth; i++) {
-            fputc(' ', fp); fputc(' ', fp);
-        }
-        fputc('[', fp); fputc('\n', fp);
-        if (node->value.array.head) {
-            /* first element */
-            curr = node->value.array.head;
-            if (curr->value)
-                dump_value(curr->value, depth + 1, fp);
-            /* other elements, if any */
-            curr = curr->next;
-            while (curr != NULL) {
-                fputc(',', fp); fputc('\n', fp);
-                if (curr->value)
-                    dump_value(curr->value, depth + 1, fp);
-                curr = curr->next;
-            }
+static json_node_t close_array(JSON json, struct json_frame* frame) {
+    struct json_node* node = NULL;
+    size_t count;
+    assert(json);
+    assert(frame);
+    node = frame->node;
+    /* move the elements from the scratch stack into a vector */
+    if ((count = json->top - frame->base) > 0) {
+        if (count > (size_t)INT_MAX) {
+            errno = EFBIG;
+            return NULL;
         }
-        fputc('\n', fp);
-        /* closing bracket */
-        for (i = 0; i < depth; i++) {
-            fputc(' ', fp); fputc(' ', fp);
+        if ((node->value.array.elem = (struct json_node**)arena_alloc(json->arena, count * sizeof(struct json_node*))) == NULL) {
+            /* errno set */
+            return NULL;
         }
-        fputc(']', fp);
-        fflush(fp);
+        (void)memcpy(node->value.array.elem, &json->stack[frame->base], count * sizeof(struct json_node*));
+        node->value.array.size = (int)count;
+        json->top = frame->base;
     }
+    DEBUG_ARRAY(node);
+    return node;
 }
 
 /*  <string>     : '"' characters '"'
@@ -953,61 +5352,61 @@ static void dump_array(json_node_t node, int depth, FILE* fp) {
  *  <onenine>    : '1' .. '9'
  *               ;
  */
-static long scan_string(JSON json) {
-    long len = 0;
-    long idx = 0;
+static size_t scan_string(JSON json) {
+    size_t len = 0;
+    size_t idx = 0;
     assert(json);
     assert(json->buf);
     assert(json->len >= 1);
     assert(json->pos <= json->len);
     idx = json->pos;
-    while ((idx < json->len) && (json->buf[idx] != '"')) {
-        /* escape '\"' (ignore the other escape sequences) */
+    while ((idx = find_special(json->buf, idx, json->len)) < json->len) {
+        /* skip escape sequences (they are not decoded) */
         if (json->buf[idx] == '\\') {
-            len++;
-            idx++;
-            if ((idx < json->len) && (json->buf[idx] == '"')) {
-                len++;
-                idx++;
-            }
+            idx += ((idx + 1U) < json->len) ? 2U : 1U;
         } else {
-            len++;
-            idx++;
+            /* closing quote or control character */
+            break;
         }
     }
+    len = idx - json->pos;
     return len;
 }
 
 static char* get_string(JSON json) {
-    char* string = NULL;
-    long length = 0;
+    const char* string = NULL;
+    size_t length = 0;
 
-    if (lookahead(json) != '"') {
-        errno = EINVAL; /* FIXME: error code */
-        return NULL;
-    }
-    if (get_char(json) != '"') {
-        errno = EINVAL; /* FIXME: error code */
+    if ((string = match_string(json, &length)) == NULL) {
+        /* errno set */
         return NULL;
     }
-    if ((length = scan_string(json)) < 0) {
-        errno = EINVAL; /* FIXME: error code */
-        return NULL;
+    if (json->insitu) {
+        /* in-situ: the closing quote becomes the terminator */
+        json->insitu[json->pos - 1] = '\0';
+        return &json->insitu[string - json->buf];
     }
-    if ((string = (char*)malloc((size_t)((unsigned long)length + 1UL))) == NULL) {
-        /* errno set */
+    return arena_strndup(json->arena, string, length);
+}
+
+static const char* match_string(JSON json, size_t* length) {
+    const char* string = NULL;
+    assert(json);
+    assert(length);
+    if (lookahead(json) != '"') {
+        parse_error(json, JSON_ERR_SYNTAX);
         return NULL;
     }
-    if ((string = strncpy(string, &json->buf[json->pos], (size_t)length)) != NULL) {
-        string[length] = '\0';
-        json->pos += length;
-        json->col += length;
-    }
-    if (get_char(json) != '"') {
-        errno = EINVAL; /* FIXME: error code */
-        free(string);
+    (void)get_char(json);
+    *length = scan_string(json);
+    string = &json->buf[json->pos];
+    json->pos += *length;
+    if ((json->pos >= json->len) || (json->buf[json->pos] != '"')) {
+        /* control character or end of text */
+        parse_error(json, JSON_ERR_STRING);
         return NULL;
     }
+    json->pos++;
     return string;
 }
 
@@ -1019,35 +5418,24 @@ static json_node_t parse_string(JSON json) {
         /* errno set */
         return NULL;
     }
-    if ((node = (struct json_node*)malloc(sizeof(struct json_node))) == NULL) {
+    if ((node = new_node(json, JSON_STRING)) == NULL) {
         /* errno set */
-        free(string);
         return NULL;
     }
-    node->type = JSON_STRING;
-    node->value.string = (char*)string;
+    node->value.string = string;
     DEBUG_STRING(node->value.string);
     return node;
 }
 
-static void free_string(json_node_t node) {
+static void dump_string(json_node_t node, int depth, struct json_writer* writer) {
+    assert(writer);
     if (node && (node->type == JSON_STRING)) {
-        if (node->value.string)
-            free(node->value.string);
-        free(node);
-    }
-}
-
-static void dump_string(json_node_t node, int depth, FILE* fp) {
-    int i;
-    assert(fp);
-    if (node && (node->type == JSON_STRING)) {
-        for (i = 0; i < depth; i++) {
-            fputc(' ', fp); fputc(' ', fp);
+        write_indent(writer, depth);
+        if (node->value.string) {
+            write_char(writer, '"');
+            write_text(writer, node->value.string, strlen(node->value.string));
+            write_char(writer, '"');
         }
-        if (node->value.string)
-            fprintf(fp, "\"%s\"", node->value.string);
-        fflush(fp);
     }
 }
 
@@ -1078,42 +5466,41 @@ static void dump_string(json_node_t node, int depth, FILE* fp) {
  *               | '-'
  *               ;
  */
-static long scan_number(JSON json) {
-    long len = 0;
-    long idx = json->pos;
+static size_t scan_number(JSON json) {
+    size_t len = 0;
+    size_t idx = json->pos;
     assert(json);
     assert(json->buf);
     assert(json->len >= 1);
     assert(json->pos <= json->len);
-    /* '0': no leading zeros */
+    /* minus sign is optional */
+    if ((idx < json->len) && (json->buf[idx] == '-')) {
+        len++;
+        idx++;
+    }
     if ((idx < json->len) && (json->buf[idx] == '0')) {
-        len = 1;
-    } else {
-        /* minus sign is optional */
-        if ((idx < json->len) && (json->buf[idx] == '-')) {
-            len++;
-            idx++;
-        }
+        /* '0': no leading zeros */
+        len++;
+        idx++;
+    } else if ((idx < json->len) && (('1' <= json->buf[idx]) && (json->buf[idx] <= '9'))) {
         /* at least '1' to '9'*/
-        if ((idx < json->len) && (('1' <= json->buf[idx]) && (json->buf[idx] <= '9'))) {
-            len++;
-            idx++;
-            /* more digits (optional) */
-            len += scan_digits(json, &idx);
-            /* fraction (optional) */
-            len += scan_fraction(json, &idx);
-            /* exponent (optional) */
-            len += scan_exponent(json, &idx);
-        } else {
-            /* error: '1' to '9' expected */
-            len = 0;
-        }
+        len++;
+        idx++;
+        /* more digits (optional) */
+        len += scan_digits(json, &idx);
+    } else {
+        /* error: '0' to '9' expected */
+        return 0;
     }
+    /* fraction (optional) */
+    len += scan_fraction(json, &idx);
+    /* exponent (optional) */
+    len += scan_exponent(json, &idx);
     return len;
 }
 
-static long scan_fraction(JSON json, long* idx) {
-    long len = 0;
+static size_t scan_fraction(JSON json, size_t* idx) {
+    size_t len = 0;
     assert(idx);
     assert(json);
     assert(json->buf);
@@ -1131,15 +5518,16 @@ static long scan_fraction(JSON json, long* idx) {
             len += scan_digits(json, idx);
         }
         else {
-            /* error: '1' to '9' expected */
+            /* error: '0' to '9' expected (not part of the number) */
+            *idx -= len;
             len = 0;
         }
     }
     return len;
 }
 
-static long scan_exponent(JSON json, long* idx) {
-    long len = 0;
+static size_t scan_exponent(JSON json, size_t* idx) {
+    size_t len = 0;
     assert(idx);
     assert(json);
     assert(json->buf);
@@ -1162,15 +5550,16 @@ static long scan_exponent(JSON json, long* idx) {
             len += scan_digits(json, idx);
         }
         else {
-            /* error: '1' to '9' expected */
+            /* error: '0' to '9' expected (not part of the number) */
+            *idx -= len;
             len = 0;
         }
     }
     return len;
 }
 
-static long scan_digits(JSON json, long* idx) {
-    long len = 0;
+static size_t scan_digits(JSON json, size_t* idx) {
+    size_t len = 0;
     assert(idx);
     assert(json);
     assert(json->buf);
@@ -1186,59 +5575,582 @@ static long scan_digits(JSON json, long* idx) {
 static json_node_t parse_number(JSON json) {
     struct json_node* node = NULL;
     char* string = NULL;
-    long length = 0;
+    size_t length = 0;
     assert(json);
-    if ((length = scan_number(json)) <= 0) {
-        errno = EINVAL; /* FIXME: error code */
+    if ((length = scan_number(json)) == 0) {
+        parse_error(json, JSON_ERR_NUMBER);
         return NULL;
     }
-    if ((string = (char*)malloc((size_t)((unsigned long)length + 1UL))) == NULL) {
+    if ((string = get_token(json, length)) == NULL) {
         /* errno set */
         return NULL;
     }
-    if ((string = strncpy(string, &json->buf[json->pos], (size_t)length)) != NULL) {
-        string[length] = '\0';
-        json->pos += length;
-        json->col += length;
-    }
-    if ((node = (struct json_node*)malloc(sizeof(struct json_node))) == NULL) {
+    if ((node = new_node(json, JSON_NUMBER)) == NULL) {
         /* errno set */
-        free(string);
         return NULL;
     }
-    node->type = JSON_NUMBER;
-    node->value.string = (char*)string;
-    DEBUG_NUMBER(node->value.string);
+    node->value.number.string = string;
+    node->value.number.flags = 0;
+    if (json->options & JSON_OPT_NUMBERS)
+        decode_number(&node->value.number, string);
+    DEBUG_NUMBER(node->value.number.string);
     return node;
 }
 
-static void free_number(json_node_t node) {
-    if (node && (node->type == JSON_NUMBER)) {
-        if (node->value.string)
-            free(node->value.string);
-        free(node);
+static void decode_number(struct json_number* number, const char* string) {
+    const char* ptr = string;
+    jint64_t value = 0;
+    int negative = 0;
+    int integral = 1;
+    int digits = 0;
+    int zeros = 0;
+    int digit;
+    int error;
+    int range = 0;
+    assert(number);
+    assert(string);
+    /* note: the string is a valid JSON number (see scan_number) */
+    if (*ptr == '-') {
+        negative = 1;
+        ptr++;
+    }
+    /* (1) integer part: accumulated with overflow check */
+    for (; ('0' <= *ptr) && (*ptr <= '9'); ptr++) {
+        digit = (int)(*ptr - '0');
+        if (!negative) {
+            if ((value > (INT64_MAXIMUM / 10)) ||
+               ((value == (INT64_MAXIMUM / 10)) && (digit > (int)(INT64_MAXIMUM % 10))))
+                integral = 0;
+            else
+                value = (value * 10) + digit;
+        } else {
+            if ((value < -(INT64_MAXIMUM / 10)) ||
+               ((value == -(INT64_MAXIMUM / 10)) && (digit > (int)(INT64_MAXIMUM % 10) + 1)))
+                integral = 0;
+            else
+                value = (value * 10) - digit;
+        }
+        /* significant digits (without leading and trailing zeros) */
+        if (digit != 0) {
+            digits += zeros + 1;
+            zeros = 0;
+        } else if (digits > 0) {
+            zeros++;
+        }
+    }
+    if ((*ptr == '\0') && integral) {
+        number->value.integer = value;
+        number->flags = JSON_NUM_INTEGER | JSON_NUM_LOSSLESS;
+        return;
+    }
+    /* (2) fraction: significant digits */
+    if (*ptr == '.') {
+        for (ptr++; ('0' <= *ptr) && (*ptr <= '9'); ptr++) {
+            if (*ptr != '0') {
+                digits += zeros + 1;
+                zeros = 0;
+            } else if (digits > 0) {
+                zeros++;
+            }
+        }
     }
+    /* (3) floating point value (correctly rounded) */
+    error = errno;
+    number->value.real = parse_double(string, &range);
+    number->flags = JSON_NUM_REAL;
+    if (!range && (digits <= DBL_DIG))
+        number->flags |= JSON_NUM_LOSSLESS;
+    errno = error;
 }
 
-static void dump_number(json_node_t node, int depth, FILE* fp) {
-    int i;
-    assert(fp);
+static jint64_t number_int64(const struct json_number* number) {
+    assert(number);
+    if (number->flags & JSON_NUM_INTEGER)
+        return number->value.integer;
+    /* floating point value: truncated, or saturated */
+    if (number->value.real >= TWO_POW_63) {
+        errno = ERANGE;
+        return INT64_MAXIMUM;
+    }
+    if ((number->value.real < -TWO_POW_63) ||
+       ((number->value.real == -TWO_POW_63) && !(number->flags & JSON_NUM_LOSSLESS))) {
+        errno = ERANGE;
+        return INT64_MINIMUM;
+    }
+    return (jint64_t)number->value.real;
+}
+
+static double number_double(const struct json_number* number) {
+    assert(number);
+    if (number->flags & JSON_NUM_INTEGER)
+        return (double)number->value.integer;
+    if ((number->value.real == HUGE_VAL) || (number->value.real == -HUGE_VAL))
+        errno = ERANGE;
+    return number->value.real;
+}
+
+/*  string to double: Clinger's fast path (exact operands), otherwise the
+ *  Eisel-Lemire algorithm with 128-bit powers of 5, and only for more than
+ *  19 significant digits (if still ambiguous) strtod() as the last resort.
+ *  Note: the string is a valid JSON number (see scan_number).
+ */
+static double parse_double(const char* string, int* range) {
+    const char* ptr = string;
+    json_uint64_t w = 0U, bits = 0U, other = 0U;
+    long q = 0L, exponent = 0L;
+    int negative = 0, minus = 0;
+    int digits = 0, truncated = 0;
+    double value;
+    assert(string);
+    assert(range);
+    if (*ptr == '-') {
+        negative = 1;
+        ptr++;
+    }
+    /* (1) significand: the first 19 significant digits */
+    for (; ('0' <= *ptr) && (*ptr <= '9'); ptr++) {
+        if (digits < DOUBLE_DIGITS) {
+            w = (w * 10U) + (json_uint64_t)(*ptr - '0');
+            digits += (w != 0U) ? 1 : 0;
+        } else {
+            truncated |= (*ptr != '0');
+            q++;
+        }
+    }
+    if (*ptr == '.') {
+        for (ptr++; ('0' <= *ptr) && (*ptr <= '9'); ptr++) {
+            if (digits < DOUBLE_DIGITS) {
+                w = (w * 10U) + (json_uint64_t)(*ptr - '0');
+                digits += (w != 0U) ? 1 : 0;
+                q--;
+            } else {
+                truncated |= (*ptr != '0');
+            }
+        }
+    }
+    /* (2) exponent (saturated) */
+    if ((*ptr == 'e') || (*ptr == 'E')) {
+        ptr++;
+        if ((*ptr == '-') || (*ptr == '+'))
+            minus = (*ptr++ == '-');
+        for (; ('0' <= *ptr) && (*ptr <= '9'); ptr++) {
+            if (exponent < EXPONENT_MAX)
+                exponent = (exponent * 10L) + (long)(*ptr - '0');
+        }
+        q += minus ? -exponent : exponent;
+    }
+    *range = 0;
+    if (w == 0U)
+        return make_double(negative ? DOUBLE_SIGN : 0U);
+#if (EXACT_DOUBLE != 0)
+    /* (3) Clinger: both operands and the result of one operation are exact */
+    if (!truncated && (w <= DOUBLE_HIDDEN) && (-POW10_EXACT <= q) && (q <= POW10_EXACT)) {
+        value = (double)(jint64_t)w;
+        value = (q < 0) ? (value / pow10_exact[-q]) : (value * pow10_exact[q]);
+        return negative ? -value : value;
+    }
+#endif
+    /* (4) Eisel-Lemire: if the significand is truncated, the result must be
+     *     the same for w and w+1 (otherwise the digits in between matter) */
+    if ((lemire_double(w, q, &bits) == 0) &&
+        (!truncated || ((lemire_double(w + 1U, q, &other) == 0) && (bits == other))))
+        value = make_double(bits | (negative ? DOUBLE_SIGN : 0U));
+    else
+        value = locale_strtod(string);
+    if ((value == HUGE_VAL) || (value == -HUGE_VAL) || ((-DBL_MIN < value) && (value < DBL_MIN)))
+        *range = 1;
+    return value;
+}
+
+/*  Eisel-Lemire: w * 10^q = w * 5^q * 2^q, with w normalized and 5^q as 128-bit
+ *  value, gives the significand and the exponent rounded to nearest (even).
+ *  Note: -1 means the product is too close to a halfway point (fallback).
+ */
+static int lemire_double(json_uint64_t w, long q, json_uint64_t* bits) {
+    json_uint64_t hi, lo, hi2, lo2, mantissa;
+    long power;
+    int lz, upper;
+    assert(bits);
+    if ((w == 0U) || (q < POW5_MIN)) {
+        *bits = 0U;
+        return 0;
+    }
+    if (q > POW5_MAX) {
+        *bits = DOUBLE_INFINITY;
+        return 0;
+    }
+    lz = leading_zeros(w);
+    w <<= lz;
+    multiply_64(w, pow5_128[2 * (q - POW5_MIN)], &hi, &lo);
+    if ((hi & 0x1FFU) == 0x1FFU) {
+        /* the lower 64 bits of the power are needed */
+        multiply_64(w, pow5_128[(2 * (q - POW5_MIN)) + 1], &hi2, &lo2);
+        lo += hi2;
+        if (hi2 > lo)
+            hi++;
+        if ((lo == ~(json_uint64_t)0) && ((q < -27L) || (q > 55L)))
+            return (-1);
+    }
+    upper = (int)(hi >> 63);
+    mantissa = hi >> (upper + 64 - DOUBLE_BITS - 3);
+    /* binary exponent: floor(q * log2(10)) + 63 (with 217706 / 2^16 ~ log2(10)) */
+    power = (q >= 0L) ? ((217706L * q) >> 16) : -(((-217706L * q) + 65535L) >> 16);
+    power += 63L + (long)upper - (long)lz + 1023L;
+    if (power <= 0L) {
+        /* subnormal (or zero) */
+        if ((-power + 1L) >= 64L) {
+            *bits = 0U;
+            return 0;
+        }
+        mantissa >>= (-power + 1L);
+        mantissa += (mantissa & 1U);
+        mantissa >>= 1;
+        *bits = mantissa | ((mantissa < DOUBLE_HIDDEN) ? 0U : DOUBLE_HIDDEN);
+        return 0;
+    }
+    /* exactly halfway: round to even (only possible for small q) */
+    if ((lo <= 1U) && (q >= -4L) && (q <= 23L) && ((mantissa & 3U) == 1U)) {
+        if ((mantissa << (upper + 64 - DOUBLE_BITS - 3)) == hi)
+            mantissa &= ~(json_uint64_t)1;
+    }
+    mantissa += (mantissa & 1U);
+    mantissa >>= 1;
+    if (mantissa >= (DOUBLE_HIDDEN << 1)) {
+        mantissa = DOUBLE_HIDDEN;
+        power++;
+    }
+    mantissa &= ~DOUBLE_HIDDEN;
+    if (power >= 0x7FFL) {
+        *bits = DOUBLE_INFINITY;
+        return 0;
+    }
+    *bits = mantissa | ((json_uint64_t)power << DOUBLE_BITS);
+    return 0;
+}
+
+/*  strtod() expects the decimal point of the current locale
+ */
+static double locale_strtod(const char* string) {
+    const struct lconv* locale = localeconv();
+    const char* point = (locale && locale->decimal_point) ? locale->decimal_point : ".";
+    char buffer[DOUBLE_LENGTH * 2];
+    char* copy = buffer;
+    size_t length, width, i, j;
+    double value;
+    assert(string);
+    if (!strcmp(point, "."))
+        return strtod(string, NULL);
+    width = strlen(point);
+    length = strlen(string) + width;
+    if ((length >= sizeof(buffer)) && ((copy = (char*)malloc(length + 1U)) == NULL))
+        return strtod(string, NULL);
+    for (i = 0U, j = 0U; string[i]; i++) {
+        if (string[i] == '.') {
+            (void)memcpy(&copy[j], point, width);
+            j += width;
+        } else
+            copy[j++] = string[i];
+    }
+    copy[j] = '\0';
+    value = strtod(copy, NULL);
+    if (copy != buffer)
+        free(copy);
+    return value;
+}
+
+static double make_double(json_uint64_t bits) {
+    double value;
+    assert(sizeof(double) == sizeof(json_uint64_t));
+    (void)memcpy(&value, &bits, sizeof(double));
+    return value;
+}
+
+static json_uint64_t double_bits(double value) {
+    json_uint64_t bits;
+    assert(sizeof(double) == sizeof(json_uint64_t));
+    (void)memcpy(&bits, &value, sizeof(double));
+    return bits;
+}
+
+static void multiply_64(json_uint64_t a, json_uint64_t b, json_uint64_t* hi, json_uint64_t* lo) {
+#if defined(__SIZEOF_INT128__)
+    __extension__ unsigned __int128 product = (unsigned __int128)a * b;
+    *hi = (json_uint64_t)(product >> 64);
+    *lo = (json_uint64_t)product;
+#else
+    json_uint64_t a_lo = a & 0xFFFFFFFFU, a_hi = a >> 32;
+    json_uint64_t b_lo = b & 0xFFFFFFFFU, b_hi = b >> 32;
+    json_uint64_t p0 = a_lo * b_lo, p1 = a_lo * b_hi;
+    json_uint64_t p2 = a_hi * b_lo, p3 = a_hi * b_hi;
+    json_uint64_t middle = (p0 >> 32) + (p1 & 0xFFFFFFFFU) + (p2 & 0xFFFFFFFFU);
+    *lo = (middle << 32) | (p0 & 0xFFFFFFFFU);
+    *hi = p3 + (p1 >> 32) + (p2 >> 32) + (middle >> 32);
+#endif
+}
+
+static int leading_zeros(json_uint64_t x) {
+#if defined(__GNUC__)
+    return (x != 0U) ? __builtin_clzll(x) : 64;
+#else
+    int n = 0;
+    if (x == 0U)
+        return 64;
+    while (!(x & DOUBLE_SIGN)) {
+        x <<= 1;
+        n++;
+    }
+    return n;
+#endif
+}
+
+/*  double to string: the digits by Grisu2 (they always read back as the same
+ *  value, but in rare cases one digit is too much), shortened if possible and
+ *  written like JavaScript does (exponent from 1e21 and below
+ *  1e-6), e.g. "0.1", "1234", "1.5e-7", "-0". Returns the length of the text.
+ *  Note: the value must be finite, the buffer at least DOUBLE_LENGTH bytes.
+ */
+static int format_double(double value, char* buffer) {
+    char digits[DOUBLE_LENGTH];
+    char* ptr = buffer;
+    int length, K, n, i;
+    assert(buffer);
+    if (double_bits(value) & DOUBLE_SIGN) {
+        *ptr++ = '-';
+        value = -value;
+    }
+    if (value == 0.0) {
+        *ptr++ = '0';
+        *ptr = '\0';
+        return (int)(ptr - buffer);
+    }
+    length = grisu_digits(value, digits, &K);
+    length = shorten_digits(value, digits, length, &K);
+    n = length + K;  /* 10^(n-1) <= value < 10^n */
+    if ((K >= 0) && (n <= 21)) {
+        /* integer: digits followed by zeros */
+        (void)memcpy(ptr, digits, (size_t)length);
+        for (ptr += length, i = 0; i < K; i++)
+            *ptr++ = '0';
+    } else if ((0 < n) && (n <= 21)) {
+        /* decimal point within the digits */
+        (void)memcpy(ptr, digits, (size_t)n);
+        ptr += n;
+        *ptr++ = '.';
+        (void)memcpy(ptr, &digits[n], (size_t)(length - n));
+        ptr += length - n;
+    } else if ((-6 < n) && (n <= 0)) {
+        /* leading zeros after the decimal point */
+        *ptr++ = '0';
+        *ptr++ = '.';
+        for (i = n; i < 0; i++)
+            *ptr++ = '0';
+        (void)memcpy(ptr, digits, (size_t)length);
+        ptr += length;
+    } else {
+        /* exponent */
+        *ptr++ = digits[0];
+        if (length > 1) {
+            *ptr++ = '.';
+            (void)memcpy(ptr, &digits[1], (size_t)(length - 1));
+            ptr += length - 1;
+        }
+        *ptr++ = 'e';
+        if (--n < 0) {
+            *ptr++ = '-';
+            n = -n;
+        }
+        if (n >= 100)
+            *ptr++ = (char)('0' + (n / 100));
+        if (n >= 10)
+            *ptr++ = (char)('0' + ((n / 10) % 10));
+        *ptr++ = (char)('0' + (n % 10));
+    }
+    *ptr = '\0';
+    return (int)(ptr - buffer);
+}
+
+/*  Grisu2 (Florian Loitsch): the digits of the value (positive, finite) with
+ *  the decimal exponent K, i.e. value = digits * 10^K. Returns the number of
+ *  digits (at most 17).
+ */
+static int grisu_digits(double value, char* buffer, int* K) {
+    json_uint64_t bits = double_bits(value);
+    struct json_diyfp v, w_plus, w_minus, c_mk, W, Wp, Wm, one;
+    json_uint64_t p2, delta, tmp, scale;
+    unsigned long p1, d;
+    double dk;
+    int length = 0, kappa, k, index, lz;
+    assert(buffer);
+    assert(K);
+    /* (1) the value and its boundaries (halfway to the neighbors) */
+    if ((bits & DOUBLE_INFINITY) != 0U) {
+        v.f = (bits & (DOUBLE_HIDDEN - 1U)) + DOUBLE_HIDDEN;
+        v.e = (int)((bits & DOUBLE_INFINITY) >> DOUBLE_BITS) - 1075;
+    } else {
+        v.f = bits & (DOUBLE_HIDDEN - 1U);
+        v.e = 1 - 1075;
+    }
+    w_plus.f = (v.f << 1) + 1U;
+    w_plus.e = v.e - 1;
+    lz = leading_zeros(w_plus.f);
+    w_plus.f <<= lz;
+    w_plus.e -= lz;
+    if (v.f == DOUBLE_HIDDEN) {
+        w_minus.f = (v.f << 2) - 1U;
+        w_minus.e = v.e - 2;
+    } else {
+        w_minus.f = (v.f << 1) - 1U;
+        w_minus.e = v.e - 1;
+    }
+    w_minus.f <<= (w_minus.e - w_plus.e);
+    w_minus.e = w_plus.e;
+    lz = leading_zeros(v.f);
+    v.f <<= lz;
+    v.e -= lz;
+    /* (2) scaled by a cached power of 10 into the range of the digit loop */
+    dk = ((double)(-61 - w_plus.e) * 0.30102999566398114) + 347.0;
+    k = (int)dk;
+    if ((dk - (double)k) > 0.0)
+        k++;
+    index = (k >> 3) + 1;
+    *K = -(-348 + (index << 3));
+    c_mk = pow10_cached[index];
+    W = diyfp_multiply(v, c_mk);
+    Wp = diyfp_multiply(w_plus, c_mk);
+    Wm = diyfp_multiply(w_minus, c_mk);
+    Wm.f++;
+    Wp.f--;
+    /* (3) digit generation (integral part, then fractional part) */
+    delta = Wp.f - Wm.f;
+    one.f = (json_uint64_t)1 << -Wp.e;
+    one.e = Wp.e;
+    p1 = (unsigned long)(Wp.f >> -one.e);
+    p2 = Wp.f & (one.f - 1U);
+    for (kappa = 1; (kappa < 10) && (p1 >= pow10_32[kappa]); kappa++)
+        ;
+    while (kappa > 0) {
+        d = p1 / pow10_32[kappa - 1];
+        p1 %= pow10_32[kappa - 1];
+        if (d || length)
+            buffer[length++] = (char)('0' + d);
+        kappa--;
+        tmp = ((json_uint64_t)p1 << -one.e) + p2;
+        if (tmp <= delta) {
+            *K += kappa;
+            grisu_round(buffer, length, delta, tmp, (json_uint64_t)pow10_32[kappa] << -one.e, Wp.f - W.f);
+            return length;
+        }
+    }
+    for (;;) {
+        p2 *= 10U;
+        delta *= 10U;
+        d = (unsigned long)(p2 >> -one.e);
+        if (d || length)
+            buffer[length++] = (char)('0' + d);
+        p2 &= one.f - 1U;
+        kappa--;
+        if (p2 < delta) {
+            *K += kappa;
+            for (scale = 1U; kappa < 0; kappa++)
+                scale *= 10U;
+            grisu_round(buffer, length, delta, p2, one.f, (Wp.f - W.f) * scale);
+            return length;
+        }
+    }
+}
+
+/*  Grisu2 is not always the shortest: drop the last digit (rounding down or
+ *  up) as long as the value still reads back the same (see lemire_double)
+ */
+static int shorten_digits(double value, char* buffer, int length, int* K) {
+    json_uint64_t bits = double_bits(value) & ~DOUBLE_SIGN;
+    json_uint64_t w, other, candidate[2];
+    int i, n;
+    assert(buffer);
+    assert(K);
+    while (length > 1) {
+        for (w = 0U, i = 0; i < (length - 1); i++)
+            w = (w * 10U) + (json_uint64_t)(buffer[i] - '0');
+        candidate[0] = (buffer[length - 1] >= '5') ? (w + 1U) : w;
+        candidate[1] = (buffer[length - 1] >= '5') ? w : (w + 1U);
+        for (i = 0; i < 2; i++) {
+            if ((lemire_double(candidate[i], (long)*K + 1L, &other) == 0) && (other == bits))
+                break;
+        }
+        if (i == 2)
+            break;
+        /* the digits of the candidate (without trailing zeros) */
+        for (w = candidate[i], *K += 1; (w % 10U) == 0U; w /= 10U)
+            *K += 1;
+        for (n = 0, other = w; other != 0U; other /= 10U)
+            n++;
+        for (length = n; n > 0; w /= 10U)
+            buffer[--n] = (char)('0' + (int)(w % 10U));
+    }
+    return length;
+}
+
+static struct json_diyfp diyfp_multiply(struct json_diyfp x, struct json_diyfp y) {
+    struct json_diyfp result;
+    json_uint64_t hi, lo;
+    multiply_64(x.f, y.f, &hi, &lo);
+    result.f = hi + (lo >> 63);  /* rounded */
+    result.e = x.e + y.e + 64;
+    return result;
+}
+
+/*  move the last digit towards the value, as long as it stays within the
+ *  boundaries and gets closer
+ */
+static void grisu_round(char* buffer, int length, json_uint64_t delta, json_uint64_t rest, json_uint64_t ten_kappa, json_uint64_t wp_w) {
+    assert(buffer);
+    assert(length > 0);
+    while ((rest < wp_w) && ((delta - rest) >= ten_kappa) &&
+           (((rest + ten_kappa) < wp_w) || ((wp_w - rest) > ((rest + ten_kappa) - wp_w)))) {
+        buffer[length - 1]--;
+        rest += ten_kappa;
+    }
+}
+
+static void dump_number(json_node_t node, int depth, struct json_writer* writer) {
+    assert(writer);
     if (node && (node->type == JSON_NUMBER)) {
-        for (i = 0; i < depth; i++) {
-            fputc(' ', fp); fputc(' ', fp);
+        write_indent(writer, depth);
+        if (node->value.number.string) {
+            write_text(writer, node->value.number.string, strlen(node->value.number.string));
         }
-        if (node->value.string)
-            fprintf(fp, "%s", node->value.string);
-        fflush(fp);
     }
 }
 
+static char* get_token(JSON json, size_t length) {
+    char* string = NULL;
+    size_t next;
+    assert(json);
+    next = json->pos + length;
+    if (json->insitu && (next < json->len) &&
+        IS_WHITESPACE(json->buf[next]) && (json->buf[next] != '\n')) {
+        /* in-situ: a trailing whitespace becomes the terminator
+         * (but not a line feed, it is needed to locate errors) */
+        string = &json->insitu[json->pos];
+        json->pos = next + 1U;
+        json->insitu[next] = '\0';
+    } else {
+        /* otherwise (e.g. followed by ',', ']' or '}'): copy it */
+        if ((string = arena_strndup(json->arena, &json->buf[json->pos], length)) == NULL) {
+            /* errno set */
+            return NULL;
+        }
+        json->pos = next;
+    }
+    return string;
+}
+
 /*  <literal>    : "true"
  *               | "false"
  *               | "null"
  *               ;
  */
-static long scan_literal(JSON json, const char* literal) {
+static size_t scan_literal(JSON json, const char* literal) {
     size_t len = 0;
     assert(json);
     assert(json->buf);
@@ -1246,72 +6158,126 @@ static long scan_literal(JSON json, const char* literal) {
     assert(json->pos <= json->len);
     assert(literal);
     len = strlen(literal);
-    if (!strncmp(&json->buf[json->pos], literal, len))
-        return (long)len;
+    if (((json->len - json->pos) >= len) &&
+        !strncmp(&json->buf[json->pos], literal, len))
+        return len;
     else
-        return (long)0;
+        return 0;
 }
 
 static json_node_t parse_literal(JSON json, json_type_t type) {
     struct json_node* node = NULL;
-    char* string = NULL;
-    long length = 0;
+    size_t length = 0;
     assert(json);
+    /* note: literals are shared nodes (flyweights) with static text,
+     *       i.e. they take no memory from the document */
     switch (type) {
-    case JSON_TRUE:  length = scan_literal(json, "true"); break;
-    case JSON_FALSE: length = scan_literal(json, "false"); break;
-    case JSON_NULL:  length = scan_literal(json, "null"); break;
+    case JSON_TRUE:  length = scan_literal(json, "true"); node = &json_true; break;
+    case JSON_FALSE: length = scan_literal(json, "false"); node = &json_false; break;
+    case JSON_NULL:  length = scan_literal(json, "null"); node = &json_null; break;
     default: 
-        errno = EINVAL; /* FIXME: error code */
-        return NULL;
-    }
-    if (length <= 0) {
-        errno = EINVAL; /* FIXME: error code */
-        return NULL;
-    }
-    if ((string = (char*)malloc((size_t)((unsigned long)length + 1UL))) == NULL) {
-        /* errno set */
+        parse_error(json, JSON_ERR_SYNTAX);
         return NULL;
     }
-    if ((string = strncpy(string, &json->buf[json->pos], (size_t)length)) != NULL) {
-        string[length] = '\0';
-        json->pos += length;
-        json->col += length;
-    }
-    if ((node = (struct json_node*)malloc(sizeof(struct json_node))) == NULL) {
-        /* errno set */
-        free(string);
+    if (length == 0) {
+        parse_error(json, JSON_ERR_LITERAL);
         return NULL;
     }
-    node->type = type;
-    node->value.string = (char*)string;
+    json->pos += length;
     DEBUG_LITERAL(node->value.string);
     return node;
 }
 
-static void free_literal(json_node_t node) {
+static void dump_literal(json_node_t node, int depth, struct json_writer* writer) {
+    assert(writer);
     if (node && ((node->type == JSON_NULL) ||
                  (node->type == JSON_FALSE) ||
                  (node->type == JSON_TRUE))) {
+        write_indent(writer, depth);
         if (node->value.string)
-            free(node->value.string);
-        free(node);
+            write_text(writer, node->value.string, strlen(node->value.string));
     }
 }
 
-static void dump_literal(json_node_t node, int depth, FILE* fp) {
-    int i;
-    assert(fp);
-    if (node && ((node->type == JSON_NULL) ||
-                 (node->type == JSON_FALSE) ||
-                 (node->type == JSON_TRUE))) {
-        for (i = 0; i < depth; i++) {
-            fputc(' ', fp); fputc(' ', fp);
+/*  output buffer: the text is collected in a large buffer and passed to the
+ *  callback when it is full (or at the end); longer texts are passed in
+ *  pieces of the buffer size (i.e. no chunk is longer than the buffer).
+ *  In memory, the buffer grows or (if it cannot) the text is truncated, but
+ *  its whole length is counted anyway.
+ */
+static void write_text(struct json_writer* writer, const char* text, size_t length) {
+    size_t room;
+    assert(writer);
+    assert(text);
+    writer->total += length;
+    if (length > (writer->size - writer->length)) {
+        if (writer->write) {
+            write_flush(writer);
+            while (length > writer->size) {
+                if (!writer->error && writer->write(writer->context, text, (jsize_t)writer->size))
+                    writer->error = errno ? errno : EIO;
+                text += writer->size;
+                length -= writer->size;
+            }
+        } else if (!writer->grow || write_grow(writer, length)) {
+            room = writer->size - writer->length;
+            (void)memcpy(&writer->buffer[writer->length], text, room);
+            writer->length += room;
+            return;
         }
-        if (node->value.string)
-            fprintf(fp, "%s", node->value.string);
-        fflush(fp);
     }
+    (void)memcpy(&writer->buffer[writer->length], text, length);
+    writer->length += length;
+}
+
+static void write_char(struct json_writer* writer, char c) {
+    assert(writer);
+    if (writer->length < writer->size) {
+        writer->buffer[writer->length++] = c;
+        writer->total++;
+    } else
+        write_text(writer, &c, 1U);
+}
+
+static void write_indent(struct json_writer* writer, int depth) {
+    static const char spaces[] = "                                                                ";
+    size_t count, length;
+    assert(writer);
+    if ((writer->indent <= 0) || (depth <= 0))
+        return;
+    count = (size_t)depth * (size_t)writer->indent;
+    while (count > 0U) {
+        length = (count < (sizeof(spaces) - 1U)) ? count : (sizeof(spaces) - 1U);
+        write_text(writer, spaces, length);
+        count -= length;
+    }
+}
+
+static void write_flush(struct json_writer* writer) {
+    assert(writer);
+    assert(writer->write);
+    if (!writer->error && (writer->length > 0U) &&
+        writer->write(writer->context, writer->buffer, (jsize_t)writer->length))
+        writer->error = errno ? errno : EIO;
+    writer->length = 0U;
+}
+
+static int write_grow(struct json_writer* writer, size_t length) {
+    char* buffer = NULL;
+    size_t size;
+    assert(writer);
+    /* note: one byte more than the size for the terminator */
+    size = (writer->size + 1U) * 2U;
+    while ((size != 0U) && ((size - 1U - writer->length) < length))
+        size *= 2U;
+    if ((size <= writer->size) || ((buffer = (char*)realloc(writer->buffer, size)) == NULL)) {
+        writer->error = ENOMEM;
+        writer->grow = 0;
+        return (-1);
+    }
+    writer->buffer = buffer;
+    writer->size = size - 1U;
+    return 0;
 }
 /** @}
  */
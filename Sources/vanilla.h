@@ -82,11 +82,71 @@ typedef size_t  jsize_t;                /* to represent the size of an object */
 #else
 typedef unsigned long  jsize_t;         /* if you don't want to include <stddef.h> */
 #endif
+/** @note        Set define OPTION_INCLUDE_STDINT_H to a non-zero value
+ *               (e.g. the build environment) to include header <stdint.h>
+ *               and use int64_t for 64-bit integer values.
+ */
+#if (OPTION_INCLUDE_STDINT_H != OPTION_DISABLED)
+#include <stdint.h>                     /* C99 standard library header */
+typedef int64_t  jint64_t;              /* to represent a 64-bit integer value */
+#elif defined(_MSC_VER)
+typedef __int64  jint64_t;              /* Microsoft's 64-bit integer type */
+#elif defined(__GNUC__)
+__extension__ typedef long long  jint64_t;  /* C90: long long as GNU extension */
+#else
+typedef long long  jint64_t;            /* if your compiler supports long long */
+#endif
 /** @} */
 
 /*  -----------  defines  ------------------------------------------------
  */
+/** @name        Parser Options
+ *  @brief       Options for reading and parsing JSON text (can be combined).
+ *  @remarks     Threads are POSIX threads (GNU C). Without them (e.g. on
+ *               Windows) option JSON_OPT_PARALLEL is ignored, and the JSON
+ *               Lines reader (json_lines_open()) runs in the calling thread.
+ *  @{ */
+#define JSON_OPT_DEFAULT  0x0000U       /**< default behavior */
+#define JSON_OPT_MMAP     0x0001U       /**< map the file into memory (if supported) */
+#define JSON_OPT_INSITU   0x0002U       /**< strings are kept in the source buffer (in-situ) */
+#define JSON_OPT_NUMBERS  0x0004U       /**< numbers are decoded once while parsing */
+#define JSON_OPT_PARALLEL 0x0010U       /**< large top-level arrays are parsed by several threads */
+/** @} */
 
+/** @name        Output Formats
+ *  @brief       Indentation of the JSON text written by json_dump_ex().
+ *  @{ */
+#define JSON_INDENT_MINIFIED  0         /**< no whitespace at all (minified) */
+#define JSON_INDENT_DEFAULT   2         /**< 2 spaces per nesting level (as json_dump()) */
+/** @} */
+
+/** @brief       Buffer size for a JSON number written by json_format_double().
+ */
+#define JSON_DOUBLE_LENGTH  32
+
+/** @name        Number Flags
+ *  @brief       Properties of a decoded JSON number (can be combined).
+ *  @{ */
+#define JSON_NUM_INTEGER  0x0001        /**< decoded as integer (within the range of jint64_t) */
+#define JSON_NUM_REAL     0x0002        /**< decoded as floating point value (double) */
+#define JSON_NUM_LOSSLESS 0x0004        /**< the decoded value reproduces the number */
+/** @} */
+
+/** @name        Error Reasons
+ *  @brief       Reasons for a failed call to read or parse JSON text.
+ *  @{ */
+#define JSON_ERR_NONE      0            /**< no error */
+#define JSON_ERR_SYNTAX    1            /**< unexpected character */
+#define JSON_ERR_END       2            /**< unexpected end of text */
+#define JSON_ERR_STRING    3            /**< invalid string (e.g. control character) */
+#define JSON_ERR_NUMBER    4            /**< invalid number */
+#define JSON_ERR_LITERAL   5            /**< invalid literal (true, false, null) */
+#define JSON_ERR_MEMORY    6            /**< out of memory */
+#define JSON_ERR_LIMIT     7            /**< implementation limit exceeded */
+#define JSON_ERR_FILE      8            /**< file could not be read */
+#define JSON_ERR_ARGUMENT  9            /**< invalid argument */
+#define JSON_ERR_DEPTH    10            /**< nesting too deep (JSON_MAX_DEPTH) */
+/** @} */
 
 /*  -----------  types  --------------------------------------------------
  */
@@ -108,23 +168,33 @@ struct json_member {                    /* dictionary member: */
     struct json_node* value;            /* - pointer to a JSON value */
     struct json_member* next;           /* - pointer to next member */
 };
+struct json_index {                     /* hash index (open addressing): */
+    unsigned long mask;                 /* - number of slots minus 1 */
+    struct json_member** slot;          /* - pointers to the members */
+};
 struct json_dict {                      /* dictionary (as a linked list): */
     struct json_member* head;           /* - pointer to first member */
     struct json_member* curr;           /* - pointer to current member */
+    struct json_index* index;           /* - hash index of the members, or NULL */
 };
-struct json_element {                   /* array element: */
-    int index;                          /* - index (zero-based) */
-    struct json_node* value;            /* - pointer to a JSON value */
-    struct json_element* next;          /* - pointer to next element */
+struct json_array {                     /* array (as a vector): */
+    struct json_node** elem;            /* - pointers to the elements (contiguous) */
+    int size;                           /* - number of elements */
+    int curr;                           /* - index of current element, or -1 */
 };
-struct json_array {                     /* array (as a linked list): */
-    struct json_element* head;          /* - pointer to first element */
-    struct json_element* curr;          /* - pointer to current element */
+struct json_number {                    /* number: */
+    char *string;                       /* - number (as zero-terminated string) */
+    union {                             /* - decoded value (JSON_OPT_NUMBERS): */
+        jint64_t integer;               /*   - as integer (JSON_NUM_INTEGER) */
+        double real;                    /*   - as floating point (JSON_NUM_REAL) */
+    } value;
+    int flags;                          /* - number flags, or 0 if not decoded */
 };
 struct json_node {                      /* JSON node: */
     json_type_t type;                   /* - JSON value type */
     union {                             /* - JSON value: */
-        char *string;                   /*   - a JSON string or number or literal value */
+        char *string;                   /*   - a JSON string or literal value */
+        struct json_number number;      /*   - a JSON number (string and value) */
         struct json_dict dict;          /*   - a JSON key:value dictionary */
         struct json_array array;        /*   - an array of JSON values */
     } value;
@@ -133,6 +203,81 @@ struct json_node {                      /* JSON node: */
  */
 typedef struct json_node *json_node_t;  /* opaque data type! */
 
+/** @brief       JSON iterator (position in a JSON object or array)
+ *
+ *  @remarks     The iterator is owned by the caller (e.g. on the stack) and
+ *               the JSON node is not modified, i.e. several threads resp.
+ *               nested loops can iterate over the same node at the same time.
+ */
+typedef struct json_iter {              /* JSON iterator: */
+    const struct json_node* node;       /**< JSON object or array */
+    const struct json_member* member;   /**< current member (JSON object), or NULL */
+    int index;                          /**< index of current member resp. element, or -1 */
+} json_iter_t;
+
+/** @brief       JSON event handler (callbacks of the event parser)
+ *
+ *  @remarks     Each callback returns 0 to continue, or a non-zero value to
+ *               stop parsing. Callbacks that are NULL are skipped.
+ *
+ *  @remarks     Strings and numbers are passed as they are in the JSON text,
+ *               i.e. not zero-terminated and with escape sequences as is.
+ *               The pointers are valid during the callback only.
+ */
+typedef struct json_handler {           /* JSON event handler: */
+    int (*start_object)(void *context); /**< beginning of an object ('{') */
+    int (*end_object)(void *context);   /**< end of an object ('}') */
+    int (*start_array)(void *context);  /**< beginning of an array ('[') */
+    int (*end_array)(void *context);    /**< end of an array (']') */
+    int (*key)(void *context, const char *string, jsize_t length);    /**< key of an object member */
+    int (*string)(void *context, const char *string, jsize_t length); /**< string value */
+    int (*number)(void *context, const char *string, jsize_t length); /**< number value */
+    int (*literal)(void *context, json_type_t type);  /**< JSON_TRUE, JSON_FALSE or JSON_NULL */
+} json_handler_t;
+
+/** @brief       JSON output callback (writes a chunk of JSON text)
+ *
+ *  @remarks     The callback returns 0 to continue, or a non-zero value to
+ *               stop writing. The chunk is not zero-terminated and is valid
+ *               during the callback only.
+ */
+typedef int (*json_write_t)(void *context, const char *data, jsize_t length);
+
+/** @brief       JSON push parser (incremental parsing of chunked input)
+ */
+typedef struct json_parser *json_parser_t;  /* opaque data type! */
+
+/** @brief       JSON Lines reader (newline-delimited JSON, one document per line)
+ */
+typedef struct json_lines *json_lines_t;  /* opaque data type! */
+
+/** @brief       JSON document (reusable, keeps its memory between documents)
+ */
+typedef struct json_doc *json_doc_t;    /* opaque data type! */
+
+/** @brief       JSON tape (compact read-only document)
+ */
+typedef struct json_tape *json_tape_t;  /* opaque data type! */
+
+/** @brief       JSON handle (a value on a JSON tape)
+ */
+typedef jsize_t json_handle_t;          /* index into the tape */
+#define JSON_HANDLE_NONE  ((json_handle_t)-1)
+
+/** @brief       JSON path (compiled JSON Pointer, RFC 6901)
+ */
+typedef struct json_path *json_path_t;  /* opaque data type! */
+
+/** @brief       JSON error (location and reason of the last error)
+ */
+typedef struct json_error {             /* JSON error: */
+    int reason;                         /**< reason (JSON_ERR_xyz) */
+    jsize_t offset;                     /**< byte offset into the text (from 0) */
+    long line;                          /**< line number (from 1) */
+    long column;                        /**< column number (from 1, tabs expanded) */
+    const char *message;                /**< reason as text */
+} json_error_t;
+
 
 /*  -----------  variables  ----------------------------------------------
  */
@@ -149,9 +294,264 @@ typedef struct json_node *json_node_t;  /* opaque data type! */
  */
 extern json_node_t json_read(const char *filename);
 
+/** @brief       reads a file with the given options and build an internal
+ *               representation of the file's content (JSON node) if it is
+ *               a valid JSON file.
+ *
+ *  @remarks     With option JSON_OPT_MMAP the file is mapped into memory
+ *               instead of being copied into a buffer (POSIX only). If the
+ *               file cannot be mapped, it is read as with json_read().
+ *               The file must not be truncated while it is parsed.
+ *
+ *  @remarks     With option JSON_OPT_INSITU the document keeps the file's
+ *               content until it is freed, and string values are pointers
+ *               into it (zero-terminated in place) instead of copies.
+ *
+ *  @param[in]   filename  - name of the file to be parsed as JSON file
+ *  @param[in]   options   - parser options (JSON_OPT_xyz), or 0
+ *
+ *  @returns     the JSON root node if successfully read, or NULL on error
+ */
+extern json_node_t json_read_ex(const char *filename, unsigned int options);
+
+/** @brief       parses a buffer in memory and build an internal representation
+ *               of the buffer's content (JSON node) if it is valid JSON text.
+ *
+ *  @remarks     The buffer is borrowed for the duration of the call only; it is
+ *               neither copied nor must it be zero-terminated.
+ *
+ *  @param[in]   buffer  - pointer to the JSON text to be parsed
+ *  @param[in]   length  - length of the JSON text (in [Byte])
+ *
+ *  @returns     the JSON root node if successfully parsed, or NULL on error
+ */
+extern json_node_t json_parse(const char *buffer, jsize_t length);
+
+/** @brief       parses a buffer in memory with the given options and build an
+ *               internal representation of the buffer's content (JSON node)
+ *               if it is valid JSON text.
+ *
+ *  @remarks     With option JSON_OPT_INSITU the buffer is copied once into
+ *               the document, and string values are pointers into the copy.
+ *               Use json_parse_insitu() to avoid this copy.
+ *
+ *  @remarks     With option JSON_OPT_PARALLEL a large top-level array is split
+ *               into slices of elements, which are parsed by one thread per
+ *               processor. The result is the same as without the option (but
+ *               the strings are copies, even with JSON_OPT_INSITU).
+ *
+ *  @param[in]   buffer  - pointer to the JSON text to be parsed
+ *  @param[in]   length  - length of the JSON text (in [Byte])
+ *  @param[in]   options - parser options (JSON_OPT_xyz), or 0
+ *
+ *  @returns     the JSON root node if successfully parsed, or NULL on error
+ */
+extern json_node_t json_parse_ex(const char *buffer, jsize_t length, unsigned int options);
+
+/** @brief       parses a buffer in memory in-situ and build an internal
+ *               representation of the buffer's content (JSON node) if it
+ *               is valid JSON text.
+ *
+ *  @remarks     The buffer is borrowed by the document, i.e. string values
+ *               are pointers into the buffer (zero-terminated in place).
+ *               The buffer is modified and must not be released before the
+ *               document is freed.
+ *
+ *  @param[in]   buffer  - pointer to the JSON text to be parsed (writable)
+ *  @param[in]   length  - length of the JSON text (in [Byte])
+ *  @param[in]   options - parser options (JSON_OPT_xyz), or 0
+ *
+ *  @returns     the JSON root node if successfully parsed, or NULL on error
+ */
+extern json_node_t json_parse_insitu(char *buffer, jsize_t length, unsigned int options);
+
+/** @brief       reads a file and reports its content as a sequence of events
+ *               to the given handler, without building a JSON tree.
+ *
+ *  @remarks     The file is mapped into memory (if supported), otherwise it is
+ *               read into a buffer. Besides that, the memory used depends on
+ *               the nesting depth only.
+ *
+ *  @param[in]   filename  - name of the file to be parsed as JSON file
+ *  @param[in]   handler   - event handler (callbacks)
+ *  @param[in]   context   - user context, passed to each callback
+ *
+ *  @returns     0 if the file was parsed completely, 1 if a callback stopped
+ *               parsing, or a negative value on error
+ */
+extern int json_read_events(const char *filename, const json_handler_t *handler, void *context);
+
+/** @brief       parses a buffer in memory and reports its content as a sequence
+ *               of events to the given handler, without building a JSON tree.
+ *
+ *  @remarks     The buffer is neither copied nor modified. Besides that, the
+ *               memory used depends on the nesting depth only.
+ *
+ *  @param[in]   buffer   - pointer to the JSON text to be parsed
+ *  @param[in]   length   - length of the JSON text (in [Byte])
+ *  @param[in]   handler  - event handler (callbacks)
+ *  @param[in]   context  - user context, passed to each callback
+ *
+ *  @returns     0 if the buffer was parsed completely, 1 if a callback stopped
+ *               parsing, or a negative value on error
+ */
+extern int json_parse_events(const char *buffer, jsize_t length, const json_handler_t *handler, void *context);
+
+/** @brief       creates a push parser, to parse JSON text that arrives in
+ *               chunks (e.g. from a socket or a pipe).
+ *
+ *  @remarks     With a handler the content is reported as a sequence of events
+ *               (see json_parse_events()), without a handler (NULL) a JSON
+ *               tree is built and returned by json_parser_finish().
+ *
+ *  @remarks     Options JSON_OPT_MMAP and JSON_OPT_INSITU are ignored, the
+ *               chunks are borrowed for the duration of the call only.
+ *
+ *  @param[in]   handler  - event handler (callbacks), or NULL
+ *  @param[in]   context  - user context, passed to each callback
+ *  @param[in]   options  - parser options (JSON_OPT_xyz), or 0
+ *
+ *  @returns     a push parser, or NULL on error
+ */
+extern json_parser_t json_parser_new(const json_handler_t *handler, void *context, unsigned int options);
+
+/** @brief       passes the next chunk of JSON text to the given push parser.
+ *
+ *  @remarks     The chunk is parsed as far as possible. A token that is split
+ *               between two chunks (e.g. a long string) is buffered until it
+ *               is complete; besides that, the text is not copied (i.e. the
+ *               whitespace between two tokens is never buffered).
+ *
+ *  @param[in]   parser  - push parser
+ *  @param[in]   chunk   - pointer to the next chunk of JSON text
+ *  @param[in]   length  - length of the chunk (in [Byte])
+ *
+ *  @returns     0 if more text is expected (or the root value is complete),
+ *               1 if a callback stopped parsing, or a negative value on error
+ */
+extern int json_parser_feed(json_parser_t parser, const char *chunk, jsize_t length);
+
+/** @brief       signals the end of the JSON text to the given push parser.
+ *
+ *  @remarks     Without a handler the JSON root node is returned, which must
+ *               be freed by json_free(). The parser must be freed anyhow.
+ *
+ *  @param[in]   parser  - push parser
+ *  @param[out]  root    - the JSON root node (tree mode), or NULL
+ *
+ *  @returns     0 if the text was parsed completely, 1 if a callback stopped
+ *               parsing, or a negative value on error
+ */
+extern int json_parser_finish(json_parser_t parser, json_node_t *root);
+
+/** @brief       frees the given push parser (and a partially built tree).
+ *
+ *  @param[in]   parser  - push parser
+ */
+extern void json_parser_free(json_parser_t parser);
+
+/** @brief       opens a JSON Lines file (NDJSON), i.e. a file with one JSON
+ *               text per line, to read its documents one after the other.
+ *
+ *  @remarks     The file is read in batches of complete lines, and the lines
+ *               of a batch are parsed by a pool of threads. At most two batches
+ *               per thread are held in memory, and the documents are returned
+ *               in the order of the lines. Empty lines (or lines with white-
+ *               space only) are skipped.
+ *
+ *  @remarks     Option JSON_OPT_MMAP is ignored.
+ *
+ *  @param[in]   filename  - name of the file to be read, or NULL for 'stdin'
+ *  @param[in]   options   - parser options (JSON_OPT_xyz), or 0
+ *  @param[in]   threads   - number of threads, incl. the calling thread (0 = one per processor,
+ *                           at most four per processor)
+ *
+ *  @returns     a JSON Lines reader, or NULL on error
+ */
+extern json_lines_t json_lines_open(const char *filename, unsigned int options, int threads);
+
+/** @brief       returns the next document from the given JSON Lines reader.
+ *
+ *  @remarks     The JSON root node must be freed by json_free(). If a line is
+ *               not valid JSON text, the error is reported with the line and
+ *               column in the file (see json_get_last_error()); the next call
+ *               continues with the next line.
+ *
+ *  @param[in]   lines  - JSON Lines reader
+ *  @param[out]  root   - the JSON root node of the next line
+ *
+ *  @returns     1 if a document was read, 0 at the end of the file, or a
+ *               negative value on error
+ */
+extern int json_lines_next(json_lines_t lines, json_node_t *root);
+
+/** @brief       closes the given JSON Lines reader (stops its threads and
+ *               frees the documents that have not been read).
+ *
+ *  @param[in]   lines  - JSON Lines reader
+ */
+extern void json_lines_close(json_lines_t lines);
+
+/** @brief       creates a reusable JSON document, i.e. the memory of the
+ *               document tree (and of the parser) is kept from one JSON text
+ *               to the next one.
+ *
+ *  @remarks     The capacity grows to the largest text parsed so far, i.e. in
+ *               the steady state no memory is allocated for a text that is not
+ *               larger (resp. not more deeply nested) than the ones before.
+ *               Option JSON_OPT_PARALLEL still allocates for its threads.
+ *
+ *  @remarks     With option JSON_OPT_INSITU the text is copied into a buffer
+ *               of the document (which is also reused).
+ *
+ *  @param[in]   options  - parser options (JSON_OPT_xyz), or 0
+ *
+ *  @returns     a reusable JSON document, or NULL on error
+ */
+extern json_doc_t json_doc_new(unsigned int options);
+
+/** @brief       parses the given JSON text into the given reusable document
+ *               and returns its JSON root node.
+ *
+ *  @remarks     The tree of the previous text is released first, i.e. all
+ *               of its nodes become invalid. The JSON root node is owned by the
+ *               document and must not be freed by json_free().
+ *
+ *  @param[in]   doc     - reusable JSON document
+ *  @param[in]   buffer  - buffer with JSON text (not necessarily zero-terminated)
+ *  @param[in]   length  - length of the JSON text (in [Byte])
+ *
+ *  @returns     the JSON root node if successfully parsed, or NULL on error
+ */
+extern json_node_t json_doc_parse(json_doc_t doc, const char *buffer, jsize_t length);
+
+/** @brief       releases the tree of the given reusable document, but keeps
+ *               its memory for the next JSON text.
+ *
+ *  @param[in]   doc  - reusable JSON document
+ */
+extern void json_doc_reset(json_doc_t doc);
+
+/** @brief       frees the memory used by the given reusable document (incl.
+ *               the tree of the last JSON text).
+ *
+ *  @param[in]   doc  - reusable JSON document
+ */
+extern void json_doc_free(json_doc_t doc);
+
 /** @brief       frees the memory used by the given JSON node and its childs.
  *
- *  @param[in]   node  - JSON node to be freed
+ *  @remarks     The whole document tree is released at once, therefore the
+ *               node must be a JSON root node as returned by json_read() or
+ *               json_parse(). All nodes of the document become invalid.
+ *
+ *  @remarks     The JSON root node of a reusable document (json_doc_parse())
+ *               is not freed; it is released by json_doc_free().
+ *
+ *  @remarks     Any other node (e.g. from json_get_value_of()) is rejected
+ *               with errno set to EINVAL; the document is left intact.
+ *
+ *  @param[in]   node  - JSON root node to be freed
  */
 extern void json_free(json_node_t node);
 
@@ -166,6 +566,13 @@ extern json_type_t json_get_value_type(json_node_t node);
 /** @brief       returns the JSON node of the JSON object member specified by
  *               the given string, if the given node is a JSON object.
  *
+ *  @remarks     Objects with many members have a hash index, i.e. the member
+ *               is found in constant time; otherwise the members are searched
+ *               linearly. If the key is not unique, the first member is taken.
+ *
+ *  @remarks     The member is marked as the current one, i.e. the JSON node
+ *               is modified. Use json_find_value_of() for shared documents.
+ *
  *  @param[in]   string  - key of a JSON object member (string)
  *  @param[in]   node    - JSON node of type JSON object
  *
@@ -176,6 +583,9 @@ extern json_node_t json_get_value_of(const char* string, json_node_t node);
 /** @brief       returns the JSON node of the JSON array element specified by
  *               the given index, if the given node is a JSON array.
  *
+ *  @remarks     The element is marked as the current one, i.e. the JSON node
+ *               is modified. Use json_find_value_at() for shared documents.
+ *
  *  @param[in]   index  - index of a JSON array element (int)
  *  @param[in]   node   - JSON node of type JSON array
  *
@@ -189,6 +599,7 @@ extern json_node_t json_get_value_at(int index, json_node_t node);
  *
  *  @remarks     The first member resp. element of the given JSON node is
  *               marked as the current one, if any.
+ *               Use a JSON iterator (json_iter_t) for shared documents.
  * 
  *  @param[in]   node   - JSON node of type JSON object or array
  *
@@ -229,6 +640,85 @@ extern char *json_get_object_string(json_node_t node);
  */
 extern int json_get_array_index(json_node_t node);
 
+/** @brief       returns the number of elements of the given JSON node,
+ *               if the given node is a JSON array.
+ *
+ *  @param[in]   node   - JSON node of type JSON array
+ *
+ *  @returns     the number of array elements, or a negative value on error
+ */
+extern int json_get_array_size(json_node_t node);
+
+/** @brief       returns the JSON node of the JSON object member specified by
+ *               the given string, if the given node is a JSON object.
+ *
+ *  @remarks     Unlike json_get_value_of() the current member of the object
+ *               is not changed, i.e. the JSON node is only read and can be
+ *               shared by several threads.
+ *
+ *  @param[in]   string  - key of a JSON object member (string)
+ *  @param[in]   node    - JSON node of type JSON object
+ *
+ *  @returns     the JSON node of the member specified by the key, or NULL
+ */
+extern json_node_t json_find_value_of(const char *string, const struct json_node *node);
+
+/** @brief       returns the JSON node of the JSON array element specified by
+ *               the given index, if the given node is a JSON array.
+ *
+ *  @remarks     Unlike json_get_value_at() the current element of the array
+ *               is not changed, i.e. the JSON node is only read and can be
+ *               shared by several threads.
+ *
+ *  @param[in]   index  - index of a JSON array element (int)
+ *  @param[in]   node   - JSON node of type JSON array
+ *
+ *  @returns     the JSON node at the specified array index, or NULL
+ */
+extern json_node_t json_find_value_at(int index, const struct json_node *node);
+
+/** @brief       initializes the given iterator for the members resp. elements
+ *               of the given node, if the node is a JSON object or array.
+ *
+ *  @remarks     The iterator is positioned before the first member resp.
+ *               element, i.e. json_iter_next() returns the first one.
+ *
+ *  @param[out]  iter  - JSON iterator (owned by the caller)
+ *  @param[in]   node  - JSON node of type JSON object or array
+ *
+ *  @returns     0 if successful, or a negative value on error
+ */
+extern int json_iter_init(json_iter_t *iter, const struct json_node *node);
+
+/** @brief       advances the given iterator and returns the JSON node of the
+ *               next JSON object member resp. JSON array element.
+ *
+ *  @param[in]   iter  - JSON iterator
+ *
+ *  @returns     the JSON node of the next member resp. element, or NULL at
+ *               the end (or on error)
+ */
+extern json_node_t json_iter_next(json_iter_t *iter);
+
+/** @brief       returns a pointer to the key (string) of the current JSON
+ *               object member of the given iterator.
+ *
+ *  @param[in]   iter  - JSON iterator of a JSON object
+ *
+ *  @returns     the key of the current member, or NULL
+ */
+extern const char *json_iter_key(const json_iter_t *iter);
+
+/** @brief       returns the index of the current JSON object member resp.
+ *               JSON array element of the given iterator.
+ *
+ *  @param[in]   iter  - JSON iterator
+ *
+ *  @returns     the index of the current member resp. element, or a negative
+ *               value
+ */
+extern int json_iter_index(const json_iter_t *iter);
+
 /** @brief       returns a pointer to the content of the given JSON node as
  *               zero-terminated string, if the node is a JSON string.
  *
@@ -264,7 +754,9 @@ extern char *json_get_number(json_node_t node, char *buffer, jsize_t length);
 /** @brief       returns the content of the given JSON node as integer value,
  *               if the node is a JSON number.
  *
- *  @remarks     The number is converted into long by atol(); see man atol(3).
+ *  @remarks     The number is decoded like by json_get_int64() and saturated
+ *               to the range of long (errno is set to ERANGE), i.e. unlike
+ *               atol() the conversion does not depend on the locale.
  *
  *  @remarks     The buffer for the node value as zero-terminated string is
  *               optional.
@@ -280,7 +772,8 @@ extern long json_get_integer(json_node_t node, char *buffer, jsize_t length);
 /** @brief       returns the content of the given JSON node as floating point value,
  *               if the node is a JSON number.
  *
- *  @remarks     The number is converted into double by atof(); see man atof(3).
+ *  @remarks     The number is decoded like by json_get_double(), i.e. unlike
+ *               atof() correctly rounded and independent of the locale.
  *
  *  @remarks     The buffer for the node value as zero-terminated string is
  *               optional.
@@ -293,6 +786,67 @@ extern long json_get_integer(json_node_t node, char *buffer, jsize_t length);
  */
 extern double json_get_float(json_node_t node, char *buffer, jsize_t length);
 
+/** @brief       returns the content of the given JSON node as 64-bit integer
+ *               value, if the node is a JSON number.
+ *
+ *  @remarks     The value decoded while parsing is returned (JSON_OPT_NUMBERS),
+ *               otherwise the number is decoded on each call. Floating point
+ *               values are truncated towards zero.
+ *
+ *  @remarks     If the number is out of the range of jint64_t, the result is
+ *               saturated and errno is set to ERANGE.
+ *
+ *  @param[in]   node    - JSON node of type JSON number
+ *
+ *  @returns     the JSON number as 64-bit integer value, or 0 on error
+ */
+extern jint64_t json_get_int64(json_node_t node);
+
+/** @brief       returns the content of the given JSON node as floating point
+ *               value, if the node is a JSON number.
+ *
+ *  @remarks     The value decoded while parsing is returned (JSON_OPT_NUMBERS),
+ *               otherwise the number is decoded on each call. The conversion
+ *               is correctly rounded and independent of the locale.
+ *
+ *  @remarks     If the number is out of the range of double, the result is
+ *               +/-HUGE_VAL and errno is set to ERANGE.
+ *
+ *  @param[in]   node    - JSON node of type JSON number
+ *
+ *  @returns     the JSON number as floating point value, or 0.0 on error
+ */
+extern double json_get_double(json_node_t node);
+
+/** @brief       writes the given floating point value as JSON number into
+ *               the given buffer, with the fewest digits that read back as
+ *               the same value (round trip).
+ *
+ *  @remarks     The format is the one of JavaScript (but without '+' in the
+ *               exponent), e.g. "0.1", "1234", "1e21" and "1.5e-7". The
+ *               conversion is independent of the locale.
+ *
+ *  @param[in]   value   - finite floating point value (not NaN or infinity)
+ *  @param[out]  buffer  - buffer for the JSON number (zero-terminated)
+ *  @param[in]   size    - size of the buffer (in [Byte], JSON_DOUBLE_LENGTH)
+ *
+ *  @returns     the length of the JSON number, or a negative value on error
+ */
+extern int json_format_double(double value, char *buffer, jsize_t size);
+
+/** @brief       returns the properties of the decoded value of the given
+ *               JSON node, if the node is a JSON number.
+ *
+ *  @remarks     A decoded value is lossless, if it is an integer within the
+ *               range of jint64_t, or if the number has at most 15 (DBL_DIG)
+ *               significant digits and is within the range of double.
+ *
+ *  @param[in]   node    - JSON node of type JSON number
+ *
+ *  @returns     number flags (JSON_NUM_xyz), or 0 on error
+ */
+extern int json_get_number_flags(json_node_t node);
+
 /** @brief       returns the content of the given JSON node as boolean value,
  *               if the node is JSON "true" or JSON "false".
  *
@@ -321,6 +875,256 @@ extern int json_get_bool(json_node_t node, char *buffer, jsize_t length);
  */
 extern void* json_get_null(json_node_t node, char *buffer, jsize_t length);
 
+/** @brief       returns the location and the reason of the error of the last
+ *               call to read or parse JSON text (in the calling thread).
+ *
+ *  @remarks     The line and the column are computed from the byte offset
+ *               when the error occurs, they are not tracked while parsing.
+ *               The offset refers to the character where the error was
+ *               detected (or to the end of the text).
+ *
+ *  @remarks     The last error is kept per thread with GNU C and MSVC;
+ *               with other compilers it is shared by all threads.
+ *
+ *  @param[out]  error   - location and reason of the error, or NULL
+ *
+ *  @returns     the reason of the error (JSON_ERR_xyz), or JSON_ERR_NONE
+ *               if the last call was successful
+ */
+extern int json_get_last_error(json_error_t *error);
+
+/** @brief       reads a file and records its content on a JSON tape, a compact
+ *               read-only representation of the document.
+ *
+ *  @remarks     A tape is one array of tagged 64-bit words (in the order of
+ *               the text) and one buffer with all strings. Objects and arrays
+ *               know their end, i.e. a whole subtree is skipped at once. The
+ *               values are addressed by handles (see json_tape_get_xyz()).
+ *
+ *  @param[in]   filename  - name of the file to be parsed as JSON file
+ *  @param[in]   options   - parser options (JSON_OPT_NUMBERS), or 0
+ *
+ *  @returns     the JSON tape if successfully read, or NULL on error
+ */
+extern json_tape_t json_tape_read(const char *filename, unsigned int options);
+
+/** @brief       parses a buffer in memory and records its content on a JSON
+ *               tape, a compact read-only representation of the document.
+ *
+ *  @param[in]   buffer   - pointer to the JSON text to be parsed
+ *  @param[in]   length   - length of the JSON text (in [Byte])
+ *  @param[in]   options  - parser options (JSON_OPT_NUMBERS), or 0
+ *
+ *  @returns     the JSON tape if successfully parsed, or NULL on error
+ */
+extern json_tape_t json_tape_parse(const char *buffer, jsize_t length, unsigned int options);
+
+/** @brief       frees the memory used by the given JSON tape. All handles
+ *               and strings of the tape become invalid.
+ *
+ *  @param[in]   tape  - JSON tape to be freed
+ */
+extern void json_tape_free(json_tape_t tape);
+
+/** @brief       returns the handle of the root value of the given JSON tape.
+ *
+ *  @param[in]   tape  - JSON tape
+ *
+ *  @returns     the handle of the root value, or JSON_HANDLE_NONE on error
+ */
+extern json_handle_t json_tape_get_root(json_tape_t tape);
+
+/** @brief       returns the value type of the given value of a JSON tape.
+ *
+ *  @param[in]   tape   - JSON tape
+ *  @param[in]   value  - handle of a value
+ *
+ *  @returns     the JSON type of the value, or special value JSON_ERROR on error
+ */
+extern json_type_t json_tape_get_value_type(json_tape_t tape, json_handle_t value);
+
+/** @brief       returns the handle of the JSON object member specified by
+ *               the given string, if the given value is a JSON object.
+ *
+ *  @remarks     The members are searched linearly (there is no hash index),
+ *               but the value of each member is skipped at once.
+ *
+ *  @param[in]   tape    - JSON tape
+ *  @param[in]   string  - key of a JSON object member (string)
+ *  @param[in]   value   - handle of a JSON object
+ *
+ *  @returns     the handle of the member specified by the key, or JSON_HANDLE_NONE
+ */
+extern json_handle_t json_tape_get_value_of(json_tape_t tape, const char *string, json_handle_t value);
+
+/** @brief       returns the handle of the JSON array element specified by the
+ *               given index, if the given value is a JSON array.
+ *
+ *  @param[in]   tape   - JSON tape
+ *  @param[in]   index  - index of a JSON array element (int)
+ *  @param[in]   value  - handle of a JSON array
+ *
+ *  @returns     the handle of the element at the index, or JSON_HANDLE_NONE
+ */
+extern json_handle_t json_tape_get_value_at(json_tape_t tape, int index, json_handle_t value);
+
+/** @brief       returns the handle of the first JSON object member, if the
+ *               given value is a JSON object, or of the first JSON array
+ *               element, if the given value is a JSON array.
+ *
+ *  @param[in]   tape   - JSON tape
+ *  @param[in]   value  - handle of a JSON object or array
+ *
+ *  @returns     the handle of the first member resp. element, or JSON_HANDLE_NONE
+ */
+extern json_handle_t json_tape_get_value_first(json_tape_t tape, json_handle_t value);
+
+/** @brief       returns the handle of the next JSON object member resp. JSON
+ *               array element after the given one.
+ *
+ *  @remarks     Unlike json_get_value_next() the position is the handle, i.e.
+ *               the tape is not modified (and can be shared by threads).
+ *
+ *  @param[in]   tape   - JSON tape
+ *  @param[in]   value  - handle of a member resp. element
+ *
+ *  @returns     the handle of the next member resp. element, or JSON_HANDLE_NONE
+ */
+extern json_handle_t json_tape_get_value_next(json_tape_t tape, json_handle_t value);
+
+/** @brief       returns a pointer to the key (string) of the given value,
+ *               if it is a member of a JSON object.
+ *
+ *  @param[in]   tape   - JSON tape
+ *  @param[in]   value  - handle of a member
+ *
+ *  @returns     the key of the member, or NULL
+ */
+extern const char *json_tape_get_object_string(json_tape_t tape, json_handle_t value);
+
+/** @brief       returns the number of members resp. elements of the given
+ *               value, if it is a JSON object or a JSON array.
+ *
+ *  @param[in]   tape   - JSON tape
+ *  @param[in]   value  - handle of a JSON object or array
+ *
+ *  @returns     the number of members resp. elements, or a negative value on error
+ */
+extern int json_tape_get_size(json_tape_t tape, json_handle_t value);
+
+/** @brief       returns a pointer to the given value as zero-terminated string,
+ *               if it is a JSON string.
+ *
+ *  @param[in]   tape   - JSON tape
+ *  @param[in]   value  - handle of a JSON string
+ *
+ *  @returns     pointer to the JSON string value, or NULL on error
+ */
+extern const char *json_tape_get_string(json_tape_t tape, json_handle_t value);
+
+/** @brief       returns a pointer to the given value as zero-terminated string,
+ *               if it is a JSON number.
+ *
+ *  @param[in]   tape   - JSON tape
+ *  @param[in]   value  - handle of a JSON number
+ *
+ *  @returns     pointer to the JSON number as zero-terminated string, or NULL on error
+ */
+extern const char *json_tape_get_number(json_tape_t tape, json_handle_t value);
+
+/** @brief       returns the given value as 64-bit integer value, if it is a
+ *               JSON number (see json_get_int64()).
+ *
+ *  @param[in]   tape   - JSON tape
+ *  @param[in]   value  - handle of a JSON number
+ *
+ *  @returns     the JSON number as 64-bit integer value, or 0 on error
+ */
+extern jint64_t json_tape_get_int64(json_tape_t tape, json_handle_t value);
+
+/** @brief       returns the given value as floating point value, if it is a
+ *               JSON number (see json_get_double()).
+ *
+ *  @param[in]   tape   - JSON tape
+ *  @param[in]   value  - handle of a JSON number
+ *
+ *  @returns     the JSON number as floating point value, or 0.0 on error
+ */
+extern double json_tape_get_double(json_tape_t tape, json_handle_t value);
+
+/** @brief       returns the given value as boolean value, if it is JSON "true"
+ *               or JSON "false".
+ *
+ *  @param[in]   tape   - JSON tape
+ *  @param[in]   value  - handle of JSON "true" or "false"
+ *
+ *  @returns     a non-zero value for "true", 0 otherwise and on error
+ */
+extern int json_tape_get_bool(json_tape_t tape, json_handle_t value);
+
+/** @brief       compiles a JSON Pointer (RFC 6901), e.g. "/servers/3/port",
+ *               into a path that can be evaluated against many documents.
+ *
+ *  @remarks     The reference tokens are unescaped ("~1" is '/', "~0" is '~'),
+ *               hashed and converted into array indexes once. The empty string
+ *               refers to the whole document.
+ *
+ *  @remarks     Like all keys, the keys of the path are compared with the keys
+ *               as they are in the JSON text (i.e. with escape sequences as is).
+ *
+ *  @param[in]   pointer  - JSON Pointer (zero-terminated string)
+ *
+ *  @returns     the compiled JSON path, or NULL on error
+ */
+extern json_path_t json_path_compile(const char *pointer);
+
+/** @brief       frees the memory used by the given JSON path.
+ *
+ *  @param[in]   path  - JSON path to be freed
+ */
+extern void json_path_free(json_path_t path);
+
+/** @brief       returns the JSON node referred to by the given JSON path,
+ *               starting from the given node.
+ *
+ *  @remarks     The hash index of an object is used with the precomputed
+ *               hash of the key. The current member resp. element of the
+ *               nodes on the path is not changed.
+ *
+ *  @param[in]   path  - compiled JSON path
+ *  @param[in]   node  - JSON node (usually the root of a document)
+ *
+ *  @returns     the JSON node referred to by the path, or NULL
+ */
+extern json_node_t json_path_get(json_path_t path, json_node_t node);
+
+/** @brief       evaluates the given JSON paths in one walk of the tree,
+ *               starting from the given node.
+ *
+ *  @remarks     The paths are evaluated in sorted order, i.e. a common prefix
+ *               of several paths is walked only once. Each result is stored
+ *               at the position of its path; unresolved paths yield NULL.
+ *
+ *  @param[in]   paths   - array of compiled JSON paths
+ *  @param[in]   count   - number of JSON paths
+ *  @param[in]   node    - JSON node (usually the root of a document)
+ *  @param[out]  values  - array of the resulting JSON nodes (count entries)
+ *
+ *  @returns     the number of resolved paths, or a negative value on error
+ */
+extern int json_path_get_all(const json_path_t *paths, int count, json_node_t node, json_node_t *values);
+
+/** @brief       returns the handle of the value referred to by the given JSON
+ *               path, starting from the given value of a JSON tape.
+ *
+ *  @param[in]   path   - compiled JSON path
+ *  @param[in]   tape   - JSON tape
+ *  @param[in]   value  - handle of a value (usually the root)
+ *
+ *  @returns     the handle of the value referred to by the path, or JSON_HANDLE_NONE
+ */
+extern json_handle_t json_path_get_handle(json_path_t path, json_tape_t tape, json_handle_t value);
+
 /** @brief       writes the content of the given JSON node and its childs
  *               as JSON format into into a file (or to standard output). 
  *
@@ -329,6 +1133,68 @@ extern void* json_get_null(json_node_t node, char *buffer, jsize_t length);
  */
 extern void json_dump(json_node_t node, const char *filename);
 
+/** @brief       writes the content of the given JSON node and its childs
+ *               as JSON format into into a file (or to standard output),
+ *               with the given indentation.
+ *
+ *  @remarks     The text is written through an internal buffer, i.e. with
+ *               a few large writes. With JSON_INDENT_MINIFIED the text has
+ *               no whitespace at all (except the final line feed).
+ *
+ *  @param[in]   node      - JSON node to be dumped
+ *  @param[in]   filename  - name of the output file, or NULL for 'stdout'
+ *  @param[in]   indent    - number of spaces per nesting level (0 = minified)
+ *
+ *  @returns     0 if successfully written, or a negative value on error
+ */
+extern int json_dump_ex(json_node_t node, const char *filename, int indent);
+
+/** @brief       writes the content of the given JSON node and its childs
+ *               as JSON format into a buffer in memory (allocated by malloc).
+ *
+ *  @remarks     The buffer grows as required. The text is zero-terminated
+ *               and has no final line feed. The caller has to free it.
+ *
+ *  @param[in]   node    - JSON node to be dumped
+ *  @param[in]   indent  - number of spaces per nesting level (0 = minified)
+ *  @param[out]  length  - length of the JSON text (without terminator), or NULL
+ *
+ *  @returns     pointer to the JSON text, or NULL on error
+ */
+extern char *json_dump_to_buffer(json_node_t node, int indent, jsize_t *length);
+
+/** @brief       writes the content of the given JSON node and its childs
+ *               as JSON format into a buffer provided by the caller.
+ *
+ *  @remarks     The text is zero-terminated and has no final line feed. If
+ *               the buffer is too small, the text is truncated and the call
+ *               fails with ERANGE; the required length is reported anyway.
+ *
+ *  @param[in]   node    - JSON node to be dumped
+ *  @param[in]   indent  - number of spaces per nesting level (0 = minified)
+ *  @param[out]  buffer  - buffer for the JSON text
+ *  @param[in]   size    - size of the buffer (in [Byte], incl. terminator)
+ *  @param[out]  length  - length of the whole JSON text (without terminator), or NULL
+ *
+ *  @returns     0 if the text fits into the buffer, or a negative value otherwise
+ */
+extern int json_dump_to_fixed(json_node_t node, int indent, char *buffer, jsize_t size, jsize_t *length);
+
+/** @brief       writes the content of the given JSON node and its childs
+ *               as JSON format chunk by chunk to the given callback.
+ *
+ *  @remarks     The chunks are at most 64 KiB long. The text has no final
+ *               line feed.
+ *
+ *  @param[in]   node     - JSON node to be dumped
+ *  @param[in]   indent   - number of spaces per nesting level (0 = minified)
+ *  @param[in]   write    - output callback (see json_write_t)
+ *  @param[in]   context  - pointer passed to the callback, or NULL
+ *
+ *  @returns     0 if successfully written, or a negative value on error
+ */
+extern int json_dump_cb(json_node_t node, int indent, json_write_t write, void *context);
+
 /** @name        Deprecated Names
  *  @brief       Deprecated names for compatibility reasons.
  *  @remarks     Deprecated names should not be used anymore!
@@ -16,27 +16,37 @@
 #define OPT_DUMPFILE_ARG    ':'
 #define OPT_VERBOSE_LONG    "/VERBOSE"
 #define OPT_VERBOSE_SHORT   "/V"
+#define OPT_EVENTS_LONG     "/EVENTS"
+#define OPT_EVENTS_SHORT    "/E"
 #else
 #define OPT_DUMPFILE_LONG   "--dumpfile="
 #define OPT_DUMPFILE_SHORT  "-d="
 #define OPT_DUMPFILE_ARG    '='
 #define OPT_VERBOSE_LONG    "--verbose"
 #define OPT_VERBOSE_SHORT   "-v"
+#define OPT_EVENTS_LONG     "--events"
+#define OPT_EVENTS_SHORT    "-e"
 #endif
 #define MAX_BUFFER  16
+#define MAX_CHUNK   4096
+#define STDIN_NAME  "-"
 
 struct options {
     char* jsonfile;
     char* dumpfile;
     int verbose;
+    int events;
 };
 int scan_commandline(int argc, char* argv[], struct options* opts);
 void usage(char* program);
 void traverse(json_node_t node, int level);
+int events(const char* filename);
+int push(FILE* fp, const json_handler_t* handler, void* context, json_node_t* root);
 
 int main(int argc, char * argv[]) {
-    json_node_t root;
+    json_node_t root = NULL;
     struct options opts;
+    json_error_t error;
     int rc = 0;
 #if !defined(_MSC_VER)
     fprintf(stdout, "vanilla-json (%s %s %s)\n",__DATE__,__TIME__,__VERSION__);
@@ -58,12 +68,27 @@ int main(int argc, char * argv[]) {
             perror("error");
         return rc;
     }
-    root = json_read(opts.jsonfile);
-    if (root == NULL) {
+    if (opts.events) {
+        /* report the events of the event parser (no JSON tree) */
+        if (events(opts.jsonfile) < 0) {
+            perror("");
+            if (json_get_last_error(&error) != JSON_ERR_NONE && error.line)
+                fprintf(stderr, "%s:%ld:%ld: %s\n", opts.jsonfile, error.line, error.column, error.message);
+            return 1;
+        }
+        return 0;
+    }
+    if (!strcmp(opts.jsonfile, STDIN_NAME))
+        rc = push(stdin, NULL, NULL, &root);
+    else
+        root = json_read(opts.jsonfile);
+    if ((rc != 0) || (root == NULL)) {
         if (!errno)
             fprintf(stderr, "Error reading JSON file %s\n", opts.jsonfile);
         else
             perror("");
+        if (json_get_last_error(&error) != JSON_ERR_NONE && error.line)
+            fprintf(stderr, "%s:%ld:%ld: %s\n", opts.jsonfile, error.line, error.column, error.message);
         return 1;
     }
     if (opts.dumpfile) {
@@ -195,6 +220,88 @@ void traverse(json_node_t node, int level) {
     }
 }
 
+static int on_start_object(void* context) {
+    int* level = (int*)context;
+    fprintf(stdout, "%*sstart of object at level %i\n", *level * 2, "", *level + 1);
+    (*level)++;
+    return 0;
+}
+static int on_end_object(void* context) {
+    int* level = (int*)context;
+    (*level)--;
+    fprintf(stdout, "%*send of object at level %i\n", *level * 2, "", *level + 1);
+    return 0;
+}
+static int on_start_array(void* context) {
+    int* level = (int*)context;
+    fprintf(stdout, "%*sstart of array at level %i\n", *level * 2, "", *level + 1);
+    (*level)++;
+    return 0;
+}
+static int on_end_array(void* context) {
+    int* level = (int*)context;
+    (*level)--;
+    fprintf(stdout, "%*send of array at level %i\n", *level * 2, "", *level + 1);
+    return 0;
+}
+static int on_key(void* context, const char* string, jsize_t length) {
+    int* level = (int*)context;
+    fprintf(stdout, "%*skey \"%.*s\"\n", *level * 2, "", (int)length, string);
+    return 0;
+}
+static int on_string(void* context, const char* string, jsize_t length) {
+    int* level = (int*)context;
+    fprintf(stdout, "%*sstring \"%.*s\"\n", *level * 2, "", (int)length, string);
+    return 0;
+}
+static int on_number(void* context, const char* string, jsize_t length) {
+    int* level = (int*)context;
+    fprintf(stdout, "%*snumber %.*s\n", *level * 2, "", (int)length, string);
+    return 0;
+}
+static int on_literal(void* context, json_type_t type) {
+    int* level = (int*)context;
+    fprintf(stdout, "%*sliteral %s\n", *level * 2, "", (type == JSON_TRUE) ? "true" : (type == JSON_FALSE) ? "false" : "null");
+    return 0;
+}
+int events(const char* filename) {
+    json_handler_t handler;
+    int level = 0;
+
+    /* ! note: callbacks that are not needed can be left NULL */
+    memset(&handler, 0, sizeof(json_handler_t));
+    handler.start_object = on_start_object;
+    handler.end_object = on_end_object;
+    handler.start_array = on_start_array;
+    handler.end_array = on_end_array;
+    handler.key = on_key;
+    handler.string = on_string;
+    handler.number = on_number;
+    handler.literal = on_literal;
+    /* ! note: the memory used depends on the nesting depth only */
+    if (!strcmp(filename, STDIN_NAME))
+        return push(stdin, &handler, (void*)&level, NULL);
+    return json_read_events(filename, &handler, (void*)&level);
+}
+int push(FILE* fp, const json_handler_t* handler, void* context, json_node_t* root) {
+    json_parser_t parser;
+    char chunk[MAX_CHUNK];
+    size_t length;
+    int rc = 0;
+
+    if (root)
+        *root = NULL;
+    /* ! note: without a handler the push parser builds a JSON tree */
+    if ((parser = json_parser_new(handler, context, 0)) == NULL)
+        return (-1);
+    while ((rc == 0) && ((length = fread(chunk, 1, MAX_CHUNK, fp)) > 0))
+        rc = json_parser_feed(parser, chunk, (jsize_t)length);
+    if (rc == 0)
+        rc = json_parser_finish(parser, root);
+    json_parser_free(parser);
+    return rc;
+}
+
 int scan_commandline(int argc, char* argv[], struct options* opts) {
     int i; char* ptr;
 
@@ -206,6 +313,7 @@ int scan_commandline(int argc, char* argv[], struct options* opts) {
     opts->jsonfile = NULL;
     opts->dumpfile = NULL;
     opts->verbose = 0;
+    opts->events = 0;
 
     for (i = 1; i < argc; i++) {
         if (!strncmp(argv[i], OPT_DUMPFILE_LONG, strlen(OPT_DUMPFILE_LONG)) || 
@@ -229,6 +337,14 @@ int scan_commandline(int argc, char* argv[], struct options* opts) {
             }
             opts->verbose = 1;
         }
+        else if (!strcmp(argv[i], OPT_EVENTS_LONG) || 
+                 !strcmp(argv[i], OPT_EVENTS_SHORT)) {
+            if (opts->events) {
+                errno = EINVAL;
+                return (-1);
+            }
+            opts->events = 1;
+        }
         else {
             if (opts->jsonfile) {
                 errno = EINVAL;
@@ -251,11 +367,11 @@ char* basename(char* path) {
     return (ptr ? ptr : exe);
 }
 void usage(char* program) {
-    fprintf(stderr, "Usaage: %s <jsonfile> [/Dumpfile:<dumpfile>] [/Verbose]\n", basename(program));
+    fprintf(stderr, "Usaage: %s <jsonfile>|- [/Dumpfile:<dumpfile>] [/Verbose] [/Events]\n", basename(program));
 }
 #else
 #include <libgen.h>  /* see man basename(3) */
 void usage(char* program) {
-    fprintf(stderr, "Usaage: %s [--verbose] [--dumpfile=<dumpfile>] <jsonfile>\n", basename(program));
+    fprintf(stderr, "Usaage: %s [--verbose] [--events] [--dumpfile=<dumpfile>] <jsonfile>|-\n", basename(program));
 }
 #endif
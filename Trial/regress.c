@@ -0,0 +1,159 @@
+/*
+ *  regress.c
+ *  vanilla-json
+ *
+ *  Regression tests (run by 'make test').
+ *  Copyright © 2024 UV Software. All rights reserved.
+ */
+#include "vanilla.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+
+#define CHECK(cond)  check((cond) ? 1 : 0, #cond, __FILE__, __LINE__)
+
+static int failed = 0;
+static int passed = 0;
+
+static void check(int ok, const char* what, const char* file, int line);
+static void test_free_non_root(void);
+static void test_push_key_whitespace(void);
+static int on_key(void* context, const char* string, jsize_t length);
+static void test_dump_chunks(void);
+static int on_write(void* context, const char* data, jsize_t length);
+
+int main(int argc, char* argv[]) {
+    (void)argc;
+    (void)argv;
+    test_free_non_root();
+    test_push_key_whitespace();
+    test_dump_chunks();
+    fprintf(stdout, "%d passed, %d failed\n", passed, failed);
+    return failed ? 1 : 0;
+}
+
+static void check(int ok, const char* what, const char* file, int line) {
+    if (ok)
+        passed++;
+    else {
+        fprintf(stderr, "%s:%d: check failed: %s\n", file, line, what);
+        failed++;
+    }
+}
+
+/* json_free() of a node inside the tree is rejected, even if the arena data
+ * in front of the node looks like the tag of a document ("NOSJ" reads as
+ * 0x4A534F4E on little-endian machines) */
+static void test_free_non_root(void) {
+    const char* text = "[\"\", \"NOSJ\", \"NOSJ\", {\"NOSJ\": \"NOSJ\"}, true]";
+    json_node_t root = json_parse(text, (jsize_t)strlen(text));
+    int i;
+    CHECK(root != NULL);
+    if (!root)
+        return;
+    for (i = 0; i < json_get_array_size(root); i++) {
+        errno = 0;
+        json_free(json_get_value_at(i, root));
+        CHECK(errno == EINVAL);
+    }
+    errno = 0;
+    json_free(json_get_value_of("NOSJ", json_get_value_at(3, root)));
+    CHECK(errno == EINVAL);
+    /* the document is left intact */
+    CHECK(json_get_array_size(root) == 5);
+    CHECK(json_get_value_type(json_get_value_at(4, root)) == JSON_TRUE);
+    errno = 0;
+    json_free(root);
+    CHECK(errno == 0);
+}
+
+/* push parser: a key is reported when its closing quote is read, the
+ * whitespace up to the ':' is skipped chunk by chunk (not buffered) */
+static int on_key(void* context, const char* string, jsize_t length) {
+    if ((length == 1) && (string[0] == 'a'))
+        (*(int*)context)++;
+    return 0;
+}
+
+static void test_push_key_whitespace(void) {
+    json_handler_t handler;
+    json_parser_t parser = NULL;
+    json_node_t root = NULL;
+    char spaces[4096];
+    int keys = 0, rc = 0, i;
+    (void)memset(&handler, 0, sizeof(json_handler_t));
+    (void)memset(spaces, ' ', sizeof(spaces));
+    handler.key = on_key;
+    parser = json_parser_new(&handler, (void*)&keys, 0);
+    CHECK(parser != NULL);
+    if (!parser)
+        return;
+    CHECK(json_parser_feed(parser, "{\"a\"", 4) == 0);
+    CHECK(keys == 1);
+    for (i = 0; (i < 256) && (rc == 0); i++)
+        rc = json_parser_feed(parser, spaces, (jsize_t)sizeof(spaces));
+    CHECK(rc == 0);
+    CHECK(json_parser_feed(parser, "\t:\n1}", 5) == 0);
+    CHECK(json_parser_finish(parser, NULL) == 0);
+    CHECK(keys == 1);
+    json_parser_free(parser);
+    /* a missing ':' is still a syntax error */
+    parser = json_parser_new(NULL, NULL, 0);
+    CHECK(parser != NULL);
+    if (!parser)
+        return;
+    CHECK((json_parser_feed(parser, "{\"a\"  ", 6) != 0) ||
+          (json_parser_feed(parser, "  1}", 4) != 0) ||
+          (json_parser_finish(parser, &root) != 0));
+    CHECK(root == NULL);
+    json_parser_free(parser);
+    json_free(root);
+}
+
+/* json_dump_cb(): no chunk is longer than 64 KiB, even if a single string
+ * is longer (the chunks make up the same text as json_dump_to_buffer()) */
+struct output {
+    char* text;
+    size_t length;
+    size_t longest;
+};
+
+static int on_write(void* context, const char* data, jsize_t length) {
+    struct output* output = (struct output*)context;
+    (void)memcpy(&output->text[output->length], data, (size_t)length);
+    output->length += (size_t)length;
+    if ((size_t)length > output->longest)
+        output->longest = (size_t)length;
+    return 0;
+}
+
+static void test_dump_chunks(void) {
+    const size_t size = (size_t)300000U;
+    struct output output;
+    json_node_t root = NULL;
+    char* text = NULL;
+    char* dump = NULL;
+    jsize_t length = 0;
+    (void)memset(&output, 0, sizeof(struct output));
+    text = (char*)malloc(size);
+    output.text = (char*)malloc(size * 2U);
+    CHECK((text != NULL) && (output.text != NULL));
+    if (text && output.text) {
+        /* ["x...x", 1, {"a": "x...x"}] with strings of about 150 KB each */
+        (void)memset(text, 'x', size);
+        (void)memcpy(text, "[\"", 2);
+        (void)memcpy(&text[size / 2U], "\", 1, {\"a\": \"", strlen("\", 1, {\"a\": \""));
+        (void)memcpy(&text[size - 3U], "\"}]", 3);
+        root = json_parse(text, (jsize_t)size);
+        CHECK(root != NULL);
+        CHECK(json_dump_cb(root, JSON_INDENT_DEFAULT, on_write, (void*)&output) == 0);
+        CHECK((output.longest > 0U) && (output.longest <= (size_t)65536U));
+        dump = json_dump_to_buffer(root, JSON_INDENT_DEFAULT, &length);
+        CHECK((dump != NULL) && ((size_t)length == output.length) && !memcmp(dump, output.text, output.length));
+        free(dump);
+        json_free(root);
+    }
+    free(output.text);
+    free(text);
+}